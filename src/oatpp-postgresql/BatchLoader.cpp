@@ -0,0 +1,164 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BatchLoader.hpp"
+
+#include <unordered_map>
+
+namespace oatpp { namespace postgresql {
+
+BatchLoader::BatchLoader(const std::shared_ptr<Executor>& executor,
+                         const data::share::StringTemplate& queryTemplate,
+                         const oatpp::String& keysParam,
+                         const oatpp::String& keyField,
+                         const oatpp::Type* rowsType,
+                         v_int64 maxBatchSize,
+                         const std::chrono::microseconds& window)
+  : m_executor(executor)
+  , m_queryTemplate(queryTemplate)
+  , m_keysParam(keysParam)
+  , m_rowsType(rowsType)
+  , m_keyProperty(nullptr)
+  , m_batcher(maxBatchSize, window, [this](std::vector<Load>& batch) { flush(batch); })
+{
+
+  if(maxBatchSize <= 0) {
+    throw std::runtime_error("[oatpp::postgresql::BatchLoader::BatchLoader()]: "
+                             "Error. Invalid maxBatchSize. maxBatchSize must be > 0.");
+  }
+
+  if(!m_rowsType->isCollection) {
+    throw std::runtime_error("[oatpp::postgresql::BatchLoader::BatchLoader()]: "
+                             "Error. Invalid rowsType. rowsType must be a collection of oatpp::Object.");
+  }
+
+  auto collectionDispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(m_rowsType->polymorphicDispatcher);
+  const oatpp::Type* rowType = collectionDispatcher->getItemType();
+
+  if(rowType->classId.id != data::type::__class::AbstractObject::CLASS_ID.id) {
+    throw std::runtime_error("[oatpp::postgresql::BatchLoader::BatchLoader()]: "
+                             "Error. Invalid rowsType. rowsType must be a collection of oatpp::Object.");
+  }
+
+  auto objectDispatcher = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(rowType->polymorphicDispatcher);
+  const auto& fieldsMap = objectDispatcher->getProperties()->getMap();
+  auto it = fieldsMap.find(*keyField);
+  if(it == fieldsMap.end()) {
+    throw std::runtime_error("[oatpp::postgresql::BatchLoader::BatchLoader()]: "
+                             "Error. The object of type " + std::string(rowType->nameQualifier) +
+                             " has no key field " + *keyField + ".");
+  }
+  m_keyProperty = it->second;
+
+  m_batcher.start();
+
+}
+
+BatchLoader::~BatchLoader() {
+  stop();
+}
+
+std::string BatchLoader::getKeyBytes(const oatpp::Void& key) const {
+  mapping::Serializer::OutputData data;
+  m_serializer.serialize(data, key);
+  if(data.dataSize < 0) {
+    return std::string();
+  }
+  return std::string(data.data, data.dataSize);
+}
+
+void BatchLoader::flush(std::vector<Load>& batch) {
+
+  std::unordered_map<std::string, std::vector<oatpp::Void>> rowsByKey;
+
+  try {
+
+    /* one array element per distinct key */
+    oatpp::Vector<oatpp::Void> keys({});
+    for(auto& load : batch) {
+      if(rowsByKey.insert({load.keyBytes, {}}).second) {
+        keys->push_back(load.key);
+      }
+    }
+
+    auto result = m_executor->execute(m_queryTemplate, {{m_keysParam, keys}}, nullptr, nullptr);
+    if(!result->isSuccess()) {
+      auto message = result->getErrorMessage();
+      throw std::runtime_error("[oatpp::postgresql::BatchLoader::flush()]: "
+                               "Error. Batch query failed. " + (message ? *message : std::string()));
+    }
+
+    auto rows = result->fetch(m_rowsType, -1);
+    auto dispatcher = static_cast<const data::type::__class::Collection::PolymorphicDispatcher*>(m_rowsType->polymorphicDispatcher);
+
+    auto iterator = dispatcher->beginIteration(rows);
+    while(!iterator->finished()) {
+      const auto& row = iterator->get();
+      auto key = m_keyProperty->get(static_cast<oatpp::BaseObject*>(row.get()));
+      auto it = rowsByKey.find(getKeyBytes(key));
+      if(it != rowsByKey.end()) {
+        it->second.push_back(row);
+      }
+      iterator->next();
+    }
+
+  } catch (...) {
+    auto exception = std::current_exception();
+    for(auto& load : batch) {
+      load.promise.set_exception(exception);
+    }
+    return;
+  }
+
+  for(auto& load : batch) {
+    load.promise.set_value(rowsByKey[load.keyBytes]);
+  }
+
+}
+
+std::future<std::vector<oatpp::Void>> BatchLoader::load(const oatpp::Void& key) {
+
+  if(!key) {
+    throw std::runtime_error("[oatpp::postgresql::BatchLoader::load()]: Error. Key must not be null.");
+  }
+
+  Load load;
+  load.key = key;
+  load.keyBytes = getKeyBytes(key);
+  auto future = load.promise.get_future();
+
+  if(!m_batcher.submit(std::move(load))) {
+    throw std::runtime_error("[oatpp::postgresql::BatchLoader::load()]: Error. Loader is stopped.");
+  }
+
+  return future;
+
+}
+
+void BatchLoader::stop() {
+  m_batcher.stop();
+}
+
+}}
@@ -0,0 +1,131 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_postgresql_BatchLoader_hpp
+#define oatpp_postgresql_BatchLoader_hpp
+
+#include "Executor.hpp"
+#include "WindowedBatcher.hpp"
+
+#include <chrono>
+#include <future>
+#include <vector>
+
+namespace oatpp { namespace postgresql {
+
+/**
+ * Batching loader of rows by key (DataLoader pattern). <br>
+ * Collects concurrent lookups submitted by many threads within a short window and executes them as a single query
+ * with an array parameter - ex.: `SELECT * FROM users WHERE id = ANY(:ids)`. Rows are scattered back to the waiters by the key field. <br>
+ * Duplicate keys within one batch are queried once. <br>
+ * *Note: the key field of the row DTO must have the same type as the keys passed to &l:BatchLoader::load ();.*
+ */
+class BatchLoader {
+private:
+
+  struct Load {
+    oatpp::Void key;
+    std::string keyBytes;
+    std::promise<std::vector<oatpp::Void>> promise;
+  };
+
+private:
+  std::string getKeyBytes(const oatpp::Void& key) const;
+  void flush(std::vector<Load>& batch);
+private:
+  std::shared_ptr<Executor> m_executor;
+  data::share::StringTemplate m_queryTemplate;
+  oatpp::String m_keysParam;
+  const oatpp::Type* m_rowsType;
+  oatpp::BaseObject::Property* m_keyProperty;
+  mapping::Serializer m_serializer;
+  WindowedBatcher<Load> m_batcher;
+public:
+
+  /**
+   * Constructor. Starts the loading thread.
+   * @param executor - &id:oatpp::postgresql::Executor;.
+   * @param queryTemplate - query template with the array parameter of keys. Ex.: `SELECT * FROM users WHERE id = ANY(:ids)`.
+   * @param keysParam - name of the array parameter. Ex.: `ids`.
+   * @param keyField - name of the key field of the row DTO. Ex.: `id`.
+   * @param rowsType - type of the rows collection. Ex.: `oatpp::Vector<oatpp::Object<UserDto>>::Class::getType()`.
+   * @param maxBatchSize - max number of lookups in one batch.
+   * @param window - max time the first lookup of the batch waits for other lookups.
+   */
+  BatchLoader(const std::shared_ptr<Executor>& executor,
+              const data::share::StringTemplate& queryTemplate,
+              const oatpp::String& keysParam,
+              const oatpp::String& keyField,
+              const oatpp::Type* rowsType,
+              v_int64 maxBatchSize,
+              const std::chrono::microseconds& window);
+
+  /**
+   * Create shared BatchLoader of rows of DTO type `T`.
+   * @tparam T - row DTO type.
+   * @param executor - &id:oatpp::postgresql::Executor;.
+   * @param queryTemplate - query template with the array parameter of keys. Ex.: `SELECT * FROM users WHERE id = ANY(:ids)`.
+   * @param keysParam - name of the array parameter. Ex.: `ids`.
+   * @param keyField - name of the key field of the row DTO. Ex.: `id`.
+   * @param maxBatchSize - max number of lookups in one batch.
+   * @param window - max time the first lookup of the batch waits for other lookups.
+   * @return - `std::shared_ptr` to BatchLoader.
+   */
+  template<class T>
+  static std::shared_ptr<BatchLoader> createShared(const std::shared_ptr<Executor>& executor,
+                                                   const data::share::StringTemplate& queryTemplate,
+                                                   const oatpp::String& keysParam,
+                                                   const oatpp::String& keyField,
+                                                   v_int64 maxBatchSize = 256,
+                                                   const std::chrono::microseconds& window = std::chrono::microseconds(200))
+  {
+    return std::make_shared<BatchLoader>(executor, queryTemplate, keysParam, keyField,
+                                         oatpp::Vector<oatpp::Object<T>>::Class::getType(),
+                                         maxBatchSize, window);
+  }
+
+  /**
+   * Non-virtual destructor. Calls &l:BatchLoader::stop ();.
+   */
+  ~BatchLoader();
+
+  /**
+   * Load rows by key.
+   * @param key - key value. Must not be `nullptr`.
+   * @return - future of the rows with the key. Empty if there are no such rows. <br>
+   * If the batch query fails the future holds the exception.
+   */
+  std::future<std::vector<oatpp::Void>> load(const oatpp::Void& key);
+
+  /**
+   * Stop loader. Pending lookups are executed, new lookups are rejected.
+   */
+  void stop();
+
+};
+
+}}
+
+#endif // oatpp_postgresql_BatchLoader_hpp
@@ -26,6 +26,48 @@
 
 namespace oatpp { namespace postgresql {
 
+namespace {
+
+/* single writer - the connection is used by one thread at a time. No read-modify-write needed */
+void increment(std::atomic<v_int64>& counter) {
+  counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PreparedStatementsStats
+
+std::shared_ptr<PreparedStatementsStats::ConnectionCounters> PreparedStatementsStats::addConnection() {
+  auto counters = std::make_shared<ConnectionCounters>();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_connections.insert(counters);
+  return counters;
+}
+
+void PreparedStatementsStats::removeConnection(const std::shared_ptr<ConnectionCounters>& counters) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if(m_connections.erase(counters) > 0) {
+    m_closed.hits += counters->hits.load(std::memory_order_relaxed);
+    m_closed.misses += counters->misses.load(std::memory_order_relaxed);
+    m_closed.evictions += counters->evictions.load(std::memory_order_relaxed);
+  }
+}
+
+PreparedStatementsCounters PreparedStatementsStats::getCounters() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  PreparedStatementsCounters result = m_closed;
+  for(const auto& counters : m_connections) {
+    result.hits += counters->hits.load(std::memory_order_relaxed);
+    result.misses += counters->misses.load(std::memory_order_relaxed);
+    result.evictions += counters->evictions.load(std::memory_order_relaxed);
+  }
+  return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Connection
+
 void Connection::setInvalidator(const std::shared_ptr<provider::Invalidator<Connection>>& invalidator) {
   m_invalidator = invalidator;
 }
@@ -34,11 +76,22 @@ std::shared_ptr<provider::Invalidator<Connection>> Connection::getInvalidator()
   return m_invalidator;
 }
 
-ConnectionImpl::ConnectionImpl(PGconn* connection)
+ConnectionImpl::ConnectionImpl(PGconn* connection,
+                               v_int64 preparedLimit,
+                               const std::shared_ptr<PreparedStatementsStats>& stats)
   : m_connection(connection)
-{}
+  , m_preparedLimit(preparedLimit)
+  , m_stats(stats)
+{
+  if(m_stats) {
+    m_counters = m_stats->addConnection();
+  }
+}
 
 ConnectionImpl::~ConnectionImpl() {
+  if(m_stats) {
+    m_stats->removeConnection(m_counters);
+  }
   if(m_connection != nullptr) {
     PQfinish(m_connection);
   }
@@ -48,13 +101,109 @@ PGconn* ConnectionImpl::getHandle() {
   return m_connection;
 }
 
-void ConnectionImpl::setPrepared(const oatpp::String& statementName) {
-  m_prepared.insert(statementName);
+void ConnectionImpl::touch(PreparedSlot& slot) {
+  if(m_preparedLimit > 0) {
+    m_preparedLru.splice(m_preparedLru.begin(), m_preparedLru, slot.lruPosition);
+  }
+}
+
+void ConnectionImpl::setPrepared(v_int64 statementId, const oatpp::String& statementName) {
+
+  if(statementId < 0) {
+    return;
+  }
+
+  if(statementId >= (v_int64) m_slots.size()) {
+    m_slots.resize(statementId + 1);
+  }
+
+  auto& slot = m_slots[statementId];
+
+  if(slot.prepared) {
+    touch(slot);
+    return;
+  }
+
+  slot.name = statementName;
+  slot.prepared = true;
+
+  if(slot.evicted) {
+    slot.evicted = false;
+    for(auto it = m_evicted.begin(); it != m_evicted.end(); it ++) {
+      if(*it == statementId) {
+        m_evicted.erase(it);
+        break;
+      }
+    }
+  }
+
+  if(m_preparedLimit <= 0) {
+    return;
+  }
+
+  m_preparedLru.push_front(statementId);
+  slot.lruPosition = m_preparedLru.begin();
+
+  while((v_int64) m_preparedLru.size() > m_preparedLimit) {
+    auto evictedId = m_preparedLru.back();
+    m_preparedLru.pop_back();
+    auto& evicted = m_slots[evictedId];
+    evicted.prepared = false;
+    evicted.evicted = true;
+    m_evicted.push_back(evictedId);
+    if(m_counters) {
+      increment(m_counters->evictions);
+    }
+  }
+
+}
+
+bool ConnectionImpl::isPrepared(v_int64 statementId) const {
+  if(statementId < 0 || statementId >= (v_int64) m_slots.size()) {
+    return false;
+  }
+  const auto& slot = m_slots[statementId];
+  return slot.prepared || slot.evicted; // evicted but not deallocated yet - the statement still exists on the server
 }
 
-bool ConnectionImpl::isPrepared(const oatpp::String& statementName) {
-  auto it = m_prepared.find(statementName);
-  return it != m_prepared.end();
+void ConnectionImpl::recordExecution(v_int64 statementId, bool prepared) {
+
+  if(prepared && statementId >= 0 && statementId < (v_int64) m_slots.size()) {
+    auto& slot = m_slots[statementId];
+    if(slot.prepared) {
+      touch(slot);
+    } else if(slot.evicted) {
+      setPrepared(statementId, slot.name);
+    }
+  }
+
+  if(m_counters) {
+    increment(prepared ? m_counters->hits : m_counters->misses);
+  }
+
+}
+
+std::vector<oatpp::String> ConnectionImpl::getEvictedStatements() {
+  std::vector<oatpp::String> result;
+  if(m_evicted.empty()) {
+    return result;
+  }
+  result.reserve(m_evicted.size());
+  for(auto id : m_evicted) {
+    result.push_back(m_slots[id].name);
+  }
+  return result;
+}
+
+void ConnectionImpl::setDeallocated(const oatpp::String& statementName) {
+  for(auto it = m_evicted.begin(); it != m_evicted.end(); it ++) {
+    auto& slot = m_slots[*it];
+    if(slot.name == statementName) {
+      slot.evicted = false;
+      m_evicted.erase(it);
+      return;
+    }
+  }
 }
 
 }}
@@ -31,8 +31,79 @@
 
 #include <libpq-fe.h>
 
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
 namespace oatpp { namespace postgresql {
 
+/**
+ * Prepared statements cache counters.
+ */
+struct PreparedStatementsCounters {
+
+  /**
+   * Number of executions which found statement already prepared on the connection.
+   */
+  v_int64 hits = 0;
+
+  /**
+   * Number of executions which had to prepare statement.
+   */
+  v_int64 misses = 0;
+
+  /**
+   * Number of statements evicted from the connection cache.
+   */
+  v_int64 evictions = 0;
+
+};
+
+/**
+ * Prepared statements cache counters of all connections of the same &id:oatpp::postgresql::ConnectionProvider;. <br>
+ * Each connection counts into its own &l:PreparedStatementsStats::ConnectionCounters; -
+ * the query hot path never writes memory shared with other connections. Counters are summed on read.
+ */
+class PreparedStatementsStats {
+public:
+
+  /**
+   * Counters of one connection. Written only by the thread currently using the connection.
+   */
+  struct ConnectionCounters {
+    std::atomic<v_int64> hits{0};
+    std::atomic<v_int64> misses{0};
+    std::atomic<v_int64> evictions{0};
+  };
+
+private:
+  std::mutex m_mutex;
+  std::unordered_set<std::shared_ptr<ConnectionCounters>> m_connections;
+  PreparedStatementsCounters m_closed;
+public:
+
+  /**
+   * Register counters of a new connection.
+   * @return - &l:PreparedStatementsStats::ConnectionCounters;.
+   */
+  std::shared_ptr<ConnectionCounters> addConnection();
+
+  /**
+   * Unregister counters of a closed connection. Its counts are kept in the totals.
+   * @param counters - &l:PreparedStatementsStats::ConnectionCounters;.
+   */
+  void removeConnection(const std::shared_ptr<ConnectionCounters>& counters);
+
+  /**
+   * Get counters summed over all connections - both open and closed.
+   * @return - &l:PreparedStatementsCounters;.
+   */
+  PreparedStatementsCounters getCounters();
+
+};
+
 /**
  * Implementation of &id:oatpp::orm::Connection; for PostgreSQL.
  */
@@ -47,8 +118,43 @@ public:
    */
   virtual PGconn* getHandle() = 0;
 
-  virtual void setPrepared(const oatpp::String& statementName) = 0;
-  virtual bool isPrepared(const oatpp::String& statementName) = 0;
+  /**
+   * Mark statement as prepared on this connection.
+   * @param statementId - dense statement id. See &id:oatpp::postgresql::ql_template::Parser::TemplateExtra::templateId;.
+   * @param statementName - statement name.
+   */
+  virtual void setPrepared(v_int64 statementId, const oatpp::String& statementName) = 0;
+
+  /**
+   * Check if statement is prepared on this connection. Doesn't change the cache state or counters. <br>
+   * Evicted statement which is not deallocated yet is still prepared.
+   * @param statementId - dense statement id. See &id:oatpp::postgresql::ql_template::Parser::TemplateExtra::templateId;.
+   * @return
+   */
+  virtual bool isPrepared(v_int64 statementId) const = 0;
+
+  /**
+   * Record execution of the statement - call once per executed statement. <br>
+   * Counts cache hit or miss and marks prepared statement as recently used.
+   * Evicted statement which is not deallocated yet is taken back into the cache.
+   * @param statementId - dense statement id. See &id:oatpp::postgresql::ql_template::Parser::TemplateExtra::templateId;.
+   * @param prepared - `true` if the statement is executed without preparing, `false` if it's prepared for this execution.
+   */
+  virtual void recordExecution(v_int64 statementId, bool prepared) = 0;
+
+  /**
+   * Get names of statements evicted from the prepared statements cache. <br>
+   * Evicted statements still exist on the server - it's up to the caller to `DEALLOCATE` them
+   * and to report success with &l:Connection::setDeallocated ();. Until then statements stay tracked by the connection.
+   * @return
+   */
+  virtual std::vector<oatpp::String> getEvictedStatements() = 0;
+
+  /**
+   * Mark evicted statement as deallocated on the server. The statement is no longer tracked by the connection.
+   * @param statementName - statement name.
+   */
+  virtual void setDeallocated(const oatpp::String& statementName) = 0;
 
   void setInvalidator(const std::shared_ptr<provider::Invalidator<Connection>>& invalidator);
   std::shared_ptr<provider::Invalidator<Connection>> getInvalidator();
@@ -56,18 +162,47 @@ public:
 };
 
 class ConnectionImpl : public Connection {
+private:
+
+  struct PreparedSlot {
+    oatpp::String name;
+    bool prepared = false;
+    bool evicted = false;
+    std::list<v_int64>::iterator lruPosition;
+  };
+
+private:
+  void touch(PreparedSlot& slot);
 private:
   PGconn* m_connection;
-  std::unordered_set<oatpp::String> m_prepared;
+  v_int64 m_preparedLimit;
+  std::shared_ptr<PreparedStatementsStats> m_stats;
+  std::shared_ptr<PreparedStatementsStats::ConnectionCounters> m_counters;
+  std::vector<PreparedSlot> m_slots; // indexed by statement id
+  std::list<v_int64> m_preparedLru; // most recently used first. Maintained only when limit is set.
+  std::vector<v_int64> m_evicted;
 public:
 
-  ConnectionImpl(PGconn* connection);
+  /**
+   * Constructor.
+   * @param connection - PostgreSQL native connection handle.
+   * @param preparedLimit - max number of prepared statements kept on the connection. `0` - unlimited.
+   * @param stats - &l:PreparedStatementsStats; to count into. May be `nullptr`.
+   */
+  ConnectionImpl(PGconn* connection,
+                 v_int64 preparedLimit = 0,
+                 const std::shared_ptr<PreparedStatementsStats>& stats = nullptr);
+
   ~ConnectionImpl();
 
   PGconn* getHandle() override;
 
-  void setPrepared(const oatpp::String& statementName) override;
-  bool isPrepared(const oatpp::String& statementName) override;
+  void setPrepared(v_int64 statementId, const oatpp::String& statementName) override;
+  bool isPrepared(v_int64 statementId) const override;
+  void recordExecution(v_int64 statementId, bool prepared) override;
+
+  std::vector<oatpp::String> getEvictedStatements() override;
+  void setDeallocated(const oatpp::String& statementName) override;
 
 };
 
@@ -82,12 +217,24 @@ struct ConnectionAcquisitionProxy : public provider::AcquisitionProxy<Connection
     return _handle.object->getHandle();
   }
 
-  void setPrepared(const oatpp::String& statementName) override {
-    _handle.object->setPrepared(statementName);
+  void setPrepared(v_int64 statementId, const oatpp::String& statementName) override {
+    _handle.object->setPrepared(statementId, statementName);
+  }
+
+  bool isPrepared(v_int64 statementId) const override {
+    return _handle.object->isPrepared(statementId);
+  }
+
+  void recordExecution(v_int64 statementId, bool prepared) override {
+    _handle.object->recordExecution(statementId, prepared);
+  }
+
+  std::vector<oatpp::String> getEvictedStatements() override {
+    return _handle.object->getEvictedStatements();
   }
 
-  bool isPrepared(const oatpp::String& statementName) override {
-    return _handle.object->isPrepared(statementName);
+  void setDeallocated(const oatpp::String& statementName) override {
+    _handle.object->setDeallocated(statementName);
   }
 
 };
@@ -31,11 +31,27 @@ void ConnectionProvider::ConnectionInvalidator::invalidate(const std::shared_ptr
   //Do nothing.
 }
 
-ConnectionProvider::ConnectionProvider(const oatpp::String& connectionString)
+ConnectionProvider::ConnectionProvider(const oatpp::String& connectionString, v_int64 preparedStatementsLimit)
   : m_invalidator(std::make_shared<ConnectionInvalidator>())
   , m_connectionString(connectionString)
+  , m_preparedStatementsLimit(preparedStatementsLimit)
+  , m_preparedStatementsStats(std::make_shared<PreparedStatementsStats>())
 {}
 
+PreparedStatementsCounters ConnectionProvider::getPreparedStatementsCounters() const {
+  return m_preparedStatementsStats->getCounters();
+}
+
+void ConnectionProvider::setWarmUp(const std::shared_ptr<WarmUp>& warmUp) {
+  std::lock_guard<std::mutex> lock(m_warmUpMutex);
+  m_warmUp = warmUp;
+}
+
+std::shared_ptr<ConnectionProvider::WarmUp> ConnectionProvider::getWarmUp() {
+  std::lock_guard<std::mutex> lock(m_warmUpMutex);
+  return m_warmUp;
+}
+
 provider::ResourceHandle<Connection> ConnectionProvider::get() {
 
   auto handle = PQconnectdb(m_connectionString->c_str());
@@ -47,12 +63,123 @@ provider::ResourceHandle<Connection> ConnectionProvider::get() {
                              "Error. Can't connect. " + errMsg);
   }
 
-  return provider::ResourceHandle<Connection>(std::make_shared<ConnectionImpl>(handle), m_invalidator);
+  auto connection = std::make_shared<ConnectionImpl>(handle, m_preparedStatementsLimit, m_preparedStatementsStats);
+
+  auto warmUp = getWarmUp();
+  if(warmUp) {
+    warmUp->warmUp(connection);
+  }
+
+  return provider::ResourceHandle<Connection>(connection, m_invalidator);
 
 }
 
 async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&> ConnectionProvider::getAsync() {
-  throw std::runtime_error("[oatpp::postgresql::ConnectionProvider::getAsync()]: Error. Not implemented!");
+
+  class ConnectCoroutine : public async::CoroutineWithResult<ConnectCoroutine, const provider::ResourceHandle<Connection>&> {
+  private:
+    std::shared_ptr<ConnectionInvalidator> m_invalidator;
+    oatpp::String m_connectionString;
+    std::shared_ptr<WarmUp> m_warmUp;
+    v_int64 m_preparedStatementsLimit;
+    std::shared_ptr<PreparedStatementsStats> m_preparedStatementsStats;
+    std::shared_ptr<Connection> m_connection;
+    PGconn* m_handle;
+    PostgresPollingStatusType m_pollingStatus;
+    bool m_socketReady;
+  public:
+
+    ConnectCoroutine(const std::shared_ptr<ConnectionInvalidator>& invalidator,
+                     const oatpp::String& connectionString,
+                     const std::shared_ptr<WarmUp>& warmUp,
+                     v_int64 preparedStatementsLimit,
+                     const std::shared_ptr<PreparedStatementsStats>& preparedStatementsStats)
+      : m_invalidator(invalidator)
+      , m_connectionString(connectionString)
+      , m_warmUp(warmUp)
+      , m_preparedStatementsLimit(preparedStatementsLimit)
+      , m_preparedStatementsStats(preparedStatementsStats)
+      , m_handle(nullptr)
+      , m_pollingStatus(PGRES_POLLING_WRITING)
+      , m_socketReady(false)
+    {}
+
+    ~ConnectCoroutine() override {
+      if(m_handle != nullptr) {
+        PQfinish(m_handle);
+      }
+    }
+
+    Action act() override {
+
+      m_handle = PQconnectStart(m_connectionString->c_str());
+      if(m_handle == nullptr) {
+        return error<async::Error>("[oatpp::postgresql::ConnectionProvider::getAsync()]: "
+                                   "Error. Can't allocate connection.");
+      }
+
+      if(PQstatus(m_handle) == CONNECTION_BAD) {
+        return onError();
+      }
+
+      /* after PQconnectStart() behave as if PQconnectPoll() returned PGRES_POLLING_WRITING */
+      m_pollingStatus = PGRES_POLLING_WRITING;
+      return yieldTo(&ConnectCoroutine::poll);
+
+    }
+
+    Action poll() {
+
+      /* PQconnectPoll() must be called only when the socket is ready. Socket may change between polls. */
+      if(!m_socketReady) {
+        m_socketReady = true;
+        switch(m_pollingStatus) {
+          case PGRES_POLLING_READING:
+            return Action::createIOWaitAction(PQsocket(m_handle), Action::IOEventType::IO_EVENT_READ);
+          case PGRES_POLLING_WRITING:
+            return Action::createIOWaitAction(PQsocket(m_handle), Action::IOEventType::IO_EVENT_WRITE);
+          default:
+            break;
+        }
+      }
+
+      m_socketReady = false;
+      m_pollingStatus = PQconnectPoll(m_handle);
+
+      switch(m_pollingStatus) {
+        case PGRES_POLLING_OK: {
+          m_connection = std::make_shared<ConnectionImpl>(m_handle, m_preparedStatementsLimit, m_preparedStatementsStats);
+          m_handle = nullptr;
+          if(m_warmUp) {
+            return m_warmUp->warmUpAsync(m_connection).next(yieldTo(&ConnectCoroutine::onReady));
+          }
+          return yieldTo(&ConnectCoroutine::onReady);
+        }
+        case PGRES_POLLING_FAILED:
+          return onError();
+        default:
+          return repeat();
+      }
+
+    }
+
+    Action onReady() {
+      return _return(provider::ResourceHandle<Connection>(m_connection, m_invalidator));
+    }
+
+    Action onError() {
+      std::string errMsg = PQerrorMessage(m_handle);
+      PQfinish(m_handle);
+      m_handle = nullptr;
+      return error<async::Error>("[oatpp::postgresql::ConnectionProvider::getAsync()]: "
+                                 "Error. Can't connect. " + errMsg);
+    }
+
+  };
+
+  return ConnectCoroutine::startForResult(m_invalidator, m_connectionString, getWarmUp(),
+                                          m_preparedStatementsLimit, m_preparedStatementsStats);
+
 }
 
 void ConnectionProvider::stop() {
@@ -30,12 +30,43 @@
 #include "oatpp/provider/Pool.hpp"
 #include "oatpp/Types.hpp"
 
+#include <mutex>
+
 namespace oatpp { namespace postgresql {
 
 /**
  * Connection provider.
  */
 class ConnectionProvider : public provider::Provider<Connection> {
+public:
+
+  /**
+   * Connection warm-up. <br>
+   * Called for every new connection before the connection is handed out.
+   */
+  class WarmUp {
+  public:
+
+    /**
+     * Default virtual destructor.
+     */
+    virtual ~WarmUp() = default;
+
+    /**
+     * Warm-up connection.
+     * @param connection
+     */
+    virtual void warmUp(const std::shared_ptr<Connection>& connection) = 0;
+
+    /**
+     * Warm-up connection in Async manner.
+     * @param connection
+     * @return - &id:oatpp::async::CoroutineStarter;.
+     */
+    virtual async::CoroutineStarter warmUpAsync(const std::shared_ptr<Connection>& connection) = 0;
+
+  };
+
 private:
 
   class ConnectionInvalidator : public provider::Invalidator<Connection> {
@@ -46,13 +77,37 @@ private:
 private:
   std::shared_ptr<ConnectionInvalidator> m_invalidator;
   oatpp::String m_connectionString;
+  v_int64 m_preparedStatementsLimit;
+  std::shared_ptr<PreparedStatementsStats> m_preparedStatementsStats;
+private:
+  std::shared_ptr<WarmUp> m_warmUp;
+  std::mutex m_warmUpMutex;
+private:
+  std::shared_ptr<WarmUp> getWarmUp();
 public:
 
   /**
    * Constructor.
    * @param connectionString
+   * @param preparedStatementsLimit - max number of prepared statements kept on each connection. <br>
+   * When the limit is reached the least recently used statement is evicted and `DEALLOCATE`d together with the next query
+   * on that connection. `0` - unlimited.
+   */
+  ConnectionProvider(const oatpp::String& connectionString, v_int64 preparedStatementsLimit = 0);
+
+  /**
+   * Get prepared statements cache counters summed over all connections created by this provider.
+   * @return - &id:oatpp::postgresql::PreparedStatementsCounters;.
+   */
+  PreparedStatementsCounters getPreparedStatementsCounters() const;
+
+  /**
+   * Set connection warm-up. <br>
+   * Since &id:oatpp::postgresql::ConnectionPool; creates its connections through the provider
+   * the warm-up is applied to every connection added to the pool as well.
+   * @param warmUp - &l:ConnectionProvider::WarmUp;. `nullptr` to disable warm-up.
    */
-  ConnectionProvider(const oatpp::String& connectionString);
+  void setWarmUp(const std::shared_ptr<WarmUp>& warmUp);
 
   /**
    * Get Connection.
@@ -61,7 +116,10 @@ public:
   provider::ResourceHandle<Connection> get() override;
 
   /**
-   * Get Connection in Async manner.
+   * Get Connection in Async manner. <br>
+   * Connection is established with `PQconnectStart`/`PQconnectPoll` - the coroutine waits for the socket readiness
+   * in the IO event worker and never blocks the async processor thread on network IO. <br>
+   * *Note: host name resolution is still done synchronously by libpq. Use `hostaddr` to avoid it.*
    * @return - &id:oatpp::async::CoroutineStarterForResult; of `Connection`.
    */
   async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&> getAsync() override;
@@ -34,7 +34,10 @@
 #include "oatpp/macro/codegen.hpp"
 
 #include "oatpp/base/Log.hpp"
+#include "oatpp/Environment.hpp"
 
+#include <cstring>
+#include <unordered_set>
 #include <vector>
 
 namespace oatpp { namespace postgresql {
@@ -65,6 +68,55 @@ void Executor::ConnectionInvalidator::invalidate(const std::shared_ptr<orm::Conn
   invalidator->invalidate(c);
 }
 
+void Executor::QueryParams::allocate() {
+
+  if(count <= INLINE_PARAMS_COUNT) {
+    m_outData = m_inlineOutData;
+    paramOids = m_inlineOids;
+    paramValues = m_inlineValues;
+    paramLengths = m_inlineLengths;
+    paramFormats = m_inlineFormats;
+    return;
+  }
+
+  m_heapOutData.reset(new mapping::Serializer::OutputData[count]);
+  m_outData = m_heapOutData.get();
+
+  /* pointers go first - the arena is aligned for any type */
+  m_heapArena.reset(new char[count * (sizeof(const char*) + sizeof(Oid) + 2 * sizeof(int))]);
+  char* arena = m_heapArena.get();
+  paramValues = reinterpret_cast<const char**>(arena);
+  arena += count * sizeof(const char*);
+  paramOids = reinterpret_cast<Oid*>(arena);
+  arena += count * sizeof(Oid);
+  paramLengths = reinterpret_cast<int*>(arena);
+  arena += count * sizeof(int);
+  paramFormats = reinterpret_cast<int*>(arena);
+
+}
+
+void Executor::QueryParams::init(const ql_template::Parser::TemplateExtra& extra, v_int32 paramsCount) {
+
+  query = extra.preparedTemplate->c_str();
+  if(extra.templateName) {
+    queryName = extra.templateName->c_str();
+  } else {
+    queryName = nullptr;
+  }
+
+  count = paramsCount;
+  allocate();
+
+}
+
+void Executor::QueryParams::bind(v_int32 index) {
+  const auto& data = m_outData[index];
+  paramOids[index] = data.oid;
+  paramValues[index] = data.data;
+  paramLengths[index] = data.dataSize;
+  paramFormats[index] = data.dataFormat;
+}
+
 Executor::QueryParams::QueryParams(const StringTemplate& queryTemplate,
                                    const std::unordered_map<oatpp::String, oatpp::Void>& params,
                                    const mapping::Serializer& serializer,
@@ -74,61 +126,88 @@ Executor::QueryParams::QueryParams(const StringTemplate& queryTemplate,
   data::mapping::TypeResolver::Cache cache;
 
   auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  init(*extra, extra->bindingPlan.size());
 
-  query = extra->preparedTemplate->c_str();
-  if(extra->templateName) {
-    queryName = extra->templateName->c_str();
-  } else {
-    queryName = nullptr;
-  }
-
-  count = queryTemplate.getTemplateVariables().size();
+  for(v_int32 i = 0; i < count; i ++) {
 
-  outData.resize(count);
-  paramOids.resize(count);
-  paramValues.resize(count);
-  paramLengths.resize(count);
-  paramFormats.resize(count);
+    const auto& binding = extra->bindingPlan[i];
 
-  for(v_uint32 i = 0; i < count; i ++) {
-
-    const auto& var = queryTemplate.getTemplateVariables()[i];
-    auto it = params.find(var.name);
+    auto it = binding.paramName ? params.find(binding.paramName) : params.end();
+    if(it == params.end()) {
+      throw std::runtime_error("[oatpp::postgresql::Executor::QueryParams::QueryParams()]: "
+                               "Error. Parameter not found " + *binding.variableName);
+    }
 
-    auto queryParameter = parseQueryParameter(var.name);
-    if(queryParameter.name) {
+    auto& data = m_outData[i];
 
-      it = params.find(queryParameter.name);
-      if(it != params.end()) {
+    if(binding.resolved && it->second.getValueType() == binding.paramType) {
 
-        auto value = typeResolver->resolveObjectPropertyValue(it->second, queryParameter.propertyPath, cache);
-        if(value.getValueType()->classId.id == oatpp::Void::Class::CLASS_ID.id) {
-          std::string tname = "UnNamed";
-          if(extra->templateName) {
-            tname = *extra->templateName;
+      /* fast path - walk precompiled property chain */
+      if(binding.propertyChain.empty()) {
+        binding.serializerMethod(&serializer, data, it->second);
+      } else {
+        oatpp::Void value = it->second;
+        for(auto property : binding.propertyChain) {
+          if(!value) {
+            break;
           }
-          throw std::runtime_error("[oatpp::postgresql::Executor::QueryParams::QueryParams()]: "
-                                   "Error."
-                                   " Query '" + tname +
-                                   "', parameter '" + *var.name +
-                                   "' - property not found or its type is unknown.");
+          value = property->get(static_cast<oatpp::BaseObject*>(value.get()));
         }
+        binding.serializerMethod(&serializer, data, value);
+      }
 
-        auto& data = outData[i];
-        serializer.serialize(data, value);
+    } else {
 
-        paramOids[i] = data.oid;
-        paramValues[i] = data.data;
-        paramLengths[i] = data.dataSize;
-        paramFormats[i] = data.dataFormat;
+      auto value = typeResolver->resolveObjectPropertyValue(it->second, binding.propertyPath, cache);
+      if(value.getValueType()->classId.id == oatpp::Void::Class::CLASS_ID.id) {
+        std::string tname = "UnNamed";
+        if(extra->templateName) {
+          tname = *extra->templateName;
+        }
+        throw std::runtime_error("[oatpp::postgresql::Executor::QueryParams::QueryParams()]: "
+                                 "Error."
+                                 " Query '" + tname +
+                                 "', parameter '" + *binding.variableName +
+                                 "' - property not found or its type is unknown.");
+      }
 
-        continue;
+      serializer.serialize(data, value);
 
-      }
     }
 
+    bind(i);
+
+  }
+
+}
+
+Executor::QueryParams::QueryParams(const StringTemplate& queryTemplate,
+                                   const std::vector<oatpp::Void>& params,
+                                   const mapping::Serializer& serializer)
+{
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+
+  if(params.size() != extra->bindingPlan.size()) {
     throw std::runtime_error("[oatpp::postgresql::Executor::QueryParams::QueryParams()]: "
-                             "Error. Parameter not found " + *var.name);
+                             "Error. Expected " + std::to_string(extra->bindingPlan.size()) +
+                             " parameters, got " + std::to_string(params.size()) + ".");
+  }
+
+  init(*extra, params.size());
+
+  for(v_int32 i = 0; i < count; i ++) {
+
+    const auto& binding = extra->bindingPlan[i];
+    const auto& value = params[i];
+
+    if(binding.resolved && value.getValueType() == binding.valueType) {
+      binding.serializerMethod(&serializer, m_outData[i], value);
+    } else {
+      serializer.serialize(m_outData[i], value);
+    }
+
+    bind(i);
 
   }
 
@@ -138,6 +217,9 @@ Executor::Executor(const std::shared_ptr<provider::Provider<Connection>>& connec
   : m_connectionInvalidator(std::make_shared<ConnectionInvalidator>())
   , m_connectionProvider(connectionProvider)
   , m_resultMapper(std::make_shared<mapping::ResultMapper>())
+  , m_preparedTemplatesWarmUp(std::make_shared<PreparedTemplatesWarmUp>())
+  , m_autoPrepareThreshold(0)
+  , m_earlyConnectionRelease(true)
 {
   m_defaultTypeResolver->addKnownClasses({
     Uuid::Class::CLASS_ID
@@ -152,6 +234,18 @@ std::shared_ptr<data::mapping::TypeResolver> Executor::createTypeResolver() {
   return typeResolver;
 }
 
+std::shared_ptr<Executor::PreparedTemplatesWarmUp> Executor::getPreparedTemplatesWarmUp() {
+  return m_preparedTemplatesWarmUp;
+}
+
+void Executor::setAutoPrepareThreshold(v_int64 threshold) {
+  m_autoPrepareThreshold = threshold;
+}
+
+void Executor::setEarlyConnectionRelease(bool enabled) {
+  m_earlyConnectionRelease = enabled;
+}
+
 Executor::QueryParameter Executor::parseQueryParameter(const oatpp::String& paramName) {
 
   utils::parser::Caret caret(paramName);
@@ -178,25 +272,207 @@ Executor::QueryParameter Executor::parseQueryParameter(const oatpp::String& para
 
 }
 
+v_int64 Executor::getTemplateId(const oatpp::String& templateName) {
+
+  /* ids are global - connections may be shared by several executors */
+  static std::mutex mutex;
+  static std::unordered_map<oatpp::String, v_int64> ids;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = ids.find(templateName);
+  if(it != ids.end()) {
+    return it->second;
+  }
+
+  v_int64 id = (v_int64) ids.size();
+  ids.insert({templateName, id});
+  return id;
+
+}
+
+v_int64 Executor::getStatementId(const oatpp::String& statementKey) {
+
+  /* same statement - same id. Keeps names of promoted statements stable across executors */
+  static std::mutex mutex;
+  static std::unordered_map<oatpp::String, v_int64> ids;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  auto it = ids.find(statementKey);
+  if(it != ids.end()) {
+    return it->second;
+  }
+
+  v_int64 id = (v_int64) ids.size();
+  ids.insert({statementKey, id});
+  return id;
+
+}
+
+const data::share::StringTemplate& Executor::getExecutionTemplate(const StringTemplate& queryTemplate) {
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+
+  v_int64 threshold = m_autoPrepareThreshold.load(std::memory_order_relaxed);
+  if(threshold <= 0 || extra->prepare || !extra->templateName || !extra->promotable.load(std::memory_order_relaxed)) {
+    return queryTemplate;
+  }
+
+  /* stop counting once promoted */
+  if(extra->executionsCount.load(std::memory_order_relaxed) < threshold &&
+     extra->executionsCount.fetch_add(1, std::memory_order_relaxed) + 1 < threshold)
+  {
+    return queryTemplate;
+  }
+
+  auto promoted = std::atomic_load(&extra->promotedTemplate);
+  if(!promoted) {
+    promoted = promoteTemplate(queryTemplate);
+    if(!promoted) {
+      return queryTemplate;
+    }
+  }
+
+  return *promoted; // owned by the template extra - outlives the call
+
+}
+
+std::shared_ptr<data::share::StringTemplate> Executor::promoteTemplate(const StringTemplate& queryTemplate) {
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+
+  std::lock_guard<std::mutex> lock(extra->promotionMutex);
+
+  if(extra->promotedTemplate) {
+    return extra->promotedTemplate;
+  }
+
+  std::unique_ptr<Oid[]> paramTypes;
+  try {
+    paramTypes = getParamTypes(queryTemplate, extra->paramsTypeMap, m_defaultTypeResolver);
+  } catch (const std::runtime_error&) {
+    // Type info is not available. Template can't be promoted to prepared statement.
+    extra->promotable = false;
+    return nullptr;
+  }
+
+  /* statement name is unique per text and parameter types - templates of different clients may have the same name */
+  std::string statementKey = *extra->preparedTemplate;
+  for(size_t i = 0; i < extra->bindingPlan.size(); i ++) {
+    statementKey += "|" + std::to_string(paramTypes[i]);
+  }
+  oatpp::String promotedName = "oatpp_auto_" + std::to_string(getStatementId(statementKey)) +
+                               "_" + *extra->templateName;
+
+  auto promotedExtra = std::make_shared<ql_template::Parser::TemplateExtra>();
+  promotedExtra->prepare = true;
+  promotedExtra->templateName = promotedName;
+  promotedExtra->templateId = getTemplateId(promotedName);
+  promotedExtra->preparedTemplate = extra->preparedTemplate;
+  promotedExtra->paramsTypeMap = extra->paramsTypeMap;
+  promotedExtra->bindingPlan = extra->bindingPlan;
+  promotedExtra->variableSlots = extra->variableSlots;
+
+  auto promoted = std::make_shared<StringTemplate>(queryTemplate);
+  promoted->setExtraData(promotedExtra);
+  std::atomic_store(&extra->promotedTemplate, promoted);
+
+  return promoted;
+
+}
+
+std::vector<ql_template::Parser::ParameterBinding> Executor::getBindingPlan(const StringTemplate& queryTemplate,
+                                                                          const ParamsTypeMap& paramsTypeMap,
+                                                                          std::vector<v_uint32>& variableSlots)
+{
+
+  std::vector<ql_template::Parser::ParameterBinding> plan;
+  std::unordered_map<oatpp::String, v_uint32> slots;
+
+  variableSlots.clear();
+  variableSlots.reserve(queryTemplate.getTemplateVariables().size());
+
+  for(const auto& var : queryTemplate.getTemplateVariables()) {
+
+    /* repeated variable is bound once - all its occurrences refer to the same $n */
+    auto slot = slots.find(var.name);
+    if(slot != slots.end()) {
+      variableSlots.push_back(slot->second);
+      continue;
+    }
+
+    v_uint32 index = plan.size();
+    slots.insert({var.name, index});
+    variableSlots.push_back(index);
+
+    auto queryParameter = parseQueryParameter(var.name);
+
+    ql_template::Parser::ParameterBinding binding;
+    binding.variableName = var.name;
+    binding.paramName = queryParameter.name;
+    binding.propertyPath = queryParameter.propertyPath;
+
+    auto it = paramsTypeMap.find(queryParameter.name);
+    if(it != paramsTypeMap.end()) {
+      binding.paramType = it->second;
+    }
+
+    /* resolve the property chain statically - only plain DTO fields, everything else is resolved by TypeResolver */
+    const oatpp::Type* type = binding.paramType;
+    for(const auto& propertyName : binding.propertyPath) {
+      if(type == nullptr || type->classId.id != data::type::__class::AbstractObject::CLASS_ID.id) {
+        type = nullptr;
+        break;
+      }
+      auto dispatcher = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+      const auto& fieldsMap = dispatcher->getProperties()->getMap();
+      auto field = fieldsMap.find(propertyName);
+      if(field == fieldsMap.end()) {
+        type = nullptr;
+        break;
+      }
+      binding.propertyChain.push_back(field->second);
+      type = field->second->type;
+    }
+
+    if(type != nullptr) {
+      binding.serializerMethod = m_serializer.getSerializerMethod(type);
+      if(binding.serializerMethod != nullptr) {
+        binding.valueType = type;
+        binding.resolved = true;
+      }
+    }
+
+    if(!binding.resolved) {
+      binding.propertyChain.clear();
+    }
+
+    plan.push_back(binding);
+
+  }
+
+  return plan;
+
+}
+
 std::unique_ptr<Oid[]> Executor::getParamTypes(const StringTemplate& queryTemplate,
                                                const ParamsTypeMap& paramsTypeMap,
                                                const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver) {
 
   data::mapping::TypeResolver::Cache cache;
 
-  std::unique_ptr<Oid[]> result(new Oid[queryTemplate.getTemplateVariables().size()]);
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  const auto& plan = extra->bindingPlan;
 
-  for(v_uint32 i = 0; i < queryTemplate.getTemplateVariables().size(); i++) {
+  std::unique_ptr<Oid[]> result(new Oid[plan.size()]);
 
-    const auto& var = queryTemplate.getTemplateVariables()[i];
-    auto it = paramsTypeMap.find(var.name);
+  for(v_uint32 i = 0; i < plan.size(); i++) {
 
-    auto queryParameter = parseQueryParameter(var.name);
-    if(queryParameter.name) {
+    const auto& binding = plan[i];
+    if(binding.paramName) {
 
-      it = paramsTypeMap.find(queryParameter.name);
+      auto it = paramsTypeMap.find(binding.paramName);
       if(it != paramsTypeMap.end()) {
-        auto type = typeResolver->resolveObjectPropertyType(it->second, queryParameter.propertyPath, cache);
+        auto type = typeResolver->resolveObjectPropertyType(it->second, binding.propertyPath, cache);
         if(type) {
           result.get()[i] = m_serializer.getTypeOid(type);
           continue;
@@ -206,7 +482,7 @@ std::unique_ptr<Oid[]> Executor::getParamTypes(const StringTemplate& queryTempla
     }
 
     throw std::runtime_error("[oatpp::postgresql::Executor::getParamTypes()]: Error. "
-                             "Type info not found for variable " + *var.name);
+                             "Type info not found for variable " + *binding.variableName);
 
   }
 
@@ -227,179 +503,1888 @@ std::shared_ptr<QueryResult> Executor::prepareQuery(const StringTemplate& queryT
   PGresult *qres = PQprepare(pgConnection->getHandle(),
                              extra->templateName->c_str(),
                              extra->preparedTemplate->c_str(),
-                             queryTemplate.getTemplateVariables().size(),
+                             extra->bindingPlan.size(),
                              paramTypes.get());
 
   return std::make_shared<QueryResult>(qres, connection, m_resultMapper, typeResolver);
 
 }
 
-std::shared_ptr<QueryResult> Executor::executeQueryPrepared(const StringTemplate& queryTemplate,
-                                                            const std::unordered_map<oatpp::String, oatpp::Void>& params,
+std::shared_ptr<QueryResult> Executor::executeQueryPrepared(const QueryParams& queryParams,
                                                             const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                                             const provider::ResourceHandle<orm::Connection>& connection)
 {
   auto pgConnection = std::static_pointer_cast<Connection>(connection.object);
-  QueryParams queryParams(queryTemplate, params, m_serializer, typeResolver);
 
   PGresult *qres = PQexecPrepared(pgConnection->getHandle(),
                                   queryParams.queryName,
                                   queryParams.count,
-                                  queryParams.paramValues.data(),
-                                  queryParams.paramLengths.data(),
-                                  queryParams.paramFormats.data(),
+                                  queryParams.paramValues,
+                                  queryParams.paramLengths,
+                                  queryParams.paramFormats,
                                   1);
 
   return std::make_shared<QueryResult>(qres, connection, m_resultMapper, typeResolver);
 
 }
 
-std::shared_ptr<QueryResult> Executor::executeQuery(const StringTemplate& queryTemplate,
-                                                    const std::unordered_map<oatpp::String, oatpp::Void>& params,
+std::shared_ptr<QueryResult> Executor::executePipelined(const StringTemplate& queryTemplate,
+                                                        const QueryParams& queryParams,
+                                                        const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                        const provider::ResourceHandle<orm::Connection>& connection,
+                                                        bool prepareStatement,
+                                                        const std::vector<oatpp::String>& deallocate)
+{
+
+  auto pgConnection = std::static_pointer_cast<Connection>(connection.object);
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  PGconn* handle = pgConnection->getHandle();
+
+#if defined(LIBPQ_HAS_PIPELINING)
+
+  std::unique_ptr<Oid[]> paramTypes;
+  if(prepareStatement) {
+    paramTypes = getParamTypes(queryTemplate, extra->paramsTypeMap, typeResolver);
+  }
+
+  if(PQenterPipelineMode(handle) == 0) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::executePipelined()]: "
+                             "Error. Can't enter pipeline mode. " + std::string(PQerrorMessage(handle)));
+  }
+
+  /* Deallocate of evicted statements, Parse, Bind/Execute and Syncs go to the server in a single flush */
+  bool deallocateSent = sendDeallocate(deallocate, handle) == 1;
+  bool prepareSent = deallocateSent && prepareStatement && sendPrepare(queryTemplate, paramTypes.get(), handle);
+  bool sent = deallocateSent && (!prepareStatement || prepareSent) &&
+              sendQuery(queryParams, extra->prepare, handle) &&
+              sendPipelineSync(handle);
+
+  /* close commands sent so far with a sync point - so that their results can be read */
+  bool partialSynced = !sent && sendPipelineSync(handle) == 1;
+
+  if(PQflush(handle) != 0) {
+    exitPipeline(handle);
+    connection.invalidator->invalidate(connection.object);
+    throw std::runtime_error("[oatpp::postgresql::Executor::executePipelined()]: "
+                             "Error. Can't send pipeline. " + std::string(PQerrorMessage(handle)));
+  }
+
+  PGresult* prepareResult = nullptr;
+  PGresult* qres;
+
+  if(sent) {
+    readDeallocate(deallocate, *pgConnection);
+    if(prepareStatement) {
+      prepareResult = getPipelineResult(handle);
+    }
+    qres = getPipelineResult(handle);
+    skipPipelineSync(handle);
+  } else {
+    qres = PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR);
+    if(prepareSent && partialSynced) {
+      /* statement may be created on the server even though the query failed to be sent - keep track of it */
+      readDeallocate(deallocate, *pgConnection);
+      PGresult* result = getPipelineResult(handle);
+      if(PQresultStatus(result) == PGRES_COMMAND_OK) {
+        pgConnection->setPrepared(extra->templateId, extra->templateName);
+      }
+      PQclear(result);
+    }
+  }
+
+  if(!exitPipeline(handle)) {
+    if(prepareResult != nullptr) {
+      PQclear(prepareResult);
+    }
+    PQclear(qres);
+    connection.invalidator->invalidate(connection.object);
+    throw std::runtime_error("[oatpp::postgresql::Executor::executePipelined()]: "
+                             "Error. Can't exit pipeline mode. " + std::string(PQerrorMessage(handle)));
+  }
+
+  if(prepareResult != nullptr) {
+    if(PQresultStatus(prepareResult) == PGRES_COMMAND_OK) {
+      pgConnection->setPrepared(extra->templateId, extra->templateName);
+      PQclear(prepareResult);
+    } else {
+      /* execution was aborted - report the reason */
+      PQclear(qres);
+      qres = prepareResult;
+    }
+  }
+
+  return std::make_shared<QueryResult>(qres, connection, m_resultMapper, typeResolver);
+
+#else
+
+  deallocateStatements(deallocate, *pgConnection);
+
+  if(prepareStatement) {
+    auto result = prepareQuery(queryTemplate, typeResolver, connection);
+    if(!result->isSuccess()) {
+      return result;
+    }
+    pgConnection->setPrepared(extra->templateId, extra->templateName);
+  }
+
+  if(extra->prepare) {
+    return executeQueryPrepared(queryParams, typeResolver, connection);
+  }
+  return executeQuery(queryParams, typeResolver, connection);
+
+#endif
+
+}
+
+std::shared_ptr<QueryResult> Executor::executeQuery(const QueryParams& queryParams,
                                                     const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                                     const provider::ResourceHandle<orm::Connection>& connection)
 {
 
   auto pgConnection = std::static_pointer_cast<Connection>(connection.object);
-  QueryParams queryParams(queryTemplate, params, m_serializer, typeResolver);
 
   PGresult *qres = PQexecParams(pgConnection->getHandle(),
                                 queryParams.query,
                                 queryParams.count,
-                                queryParams.paramOids.data(),
-                                queryParams.paramValues.data(),
-                                queryParams.paramLengths.data(),
-                                queryParams.paramFormats.data(),
+                                queryParams.paramOids,
+                                queryParams.paramValues,
+                                queryParams.paramLengths,
+                                queryParams.paramFormats,
                                 1);
 
   return std::make_shared<QueryResult>(qres, connection, m_resultMapper, typeResolver);
 
 }
 
-data::share::StringTemplate Executor::parseQueryTemplate(const oatpp::String& name,
-                                                         const oatpp::String& text,
-                                                         const ParamsTypeMap& paramsTypeMap,
-                                                         bool prepare)
-{
-
-  auto&& t = ql_template::Parser::parseTemplate(text);
+int Executor::sendPrepare(const StringTemplate& queryTemplate, const Oid* paramTypes, PGconn* handle) {
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  return PQsendPrepare(handle,
+                       extra->templateName->c_str(),
+                       extra->preparedTemplate->c_str(),
+                       extra->bindingPlan.size(),
+                       paramTypes);
+}
 
-  auto extra = std::make_shared<ql_template::Parser::TemplateExtra>();
-  t.setExtraData(extra);
+int Executor::sendQuery(const QueryParams& queryParams, bool prepared, PGconn* handle) {
 
-  extra->prepare = prepare;
-  extra->templateName = name;
-  ql_template::TemplateValueProvider valueProvider;
-  extra->preparedTemplate = t.format(&valueProvider);
-  extra->paramsTypeMap = paramsTypeMap;
+  if(prepared) {
+    return PQsendQueryPrepared(handle,
+                               queryParams.queryName,
+                               queryParams.count,
+                               queryParams.paramValues,
+                               queryParams.paramLengths,
+                               queryParams.paramFormats,
+                               1);
+  }
 
-  return t;
+  return PQsendQueryParams(handle,
+                           queryParams.query,
+                           queryParams.count,
+                           queryParams.paramOids,
+                           queryParams.paramValues,
+                           queryParams.paramLengths,
+                           queryParams.paramFormats,
+                           1);
 
 }
 
-provider::ResourceHandle<orm::Connection> Executor::getConnection() {
-  auto connection = m_connectionProvider->get();
-  if(connection) {
-    /* set correct invalidator before cast */
-    connection.object->setInvalidator(connection.invalidator);
-    return provider::ResourceHandle<orm::Connection>(
-      connection.object,
-      m_connectionInvalidator
-    );
-  }
-  throw std::runtime_error("[oatpp::postgresql::Executor::getConnection()]: Error. Can't connect.");
+int Executor::sendPipelineSync(PGconn* handle) {
+#if defined(LIBPQ_HAS_SEND_PIPELINE_SYNC)
+  return PQsendPipelineSync(handle); // doesn't flush - pipeline is flushed once all queries are sent
+#elif defined(LIBPQ_HAS_PIPELINING)
+  return PQpipelineSync(handle);
+#else
+  (void) handle;
+  return 0;
+#endif
 }
 
-std::shared_ptr<orm::QueryResult> Executor::execute(const StringTemplate& queryTemplate,
-                                                    const std::unordered_map<oatpp::String, oatpp::Void>& params,
-                                                    const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
-                                                    const provider::ResourceHandle<orm::Connection>& connection)
-{
+PGresult* Executor::getPipelineResult(PGconn* handle) {
 
-  auto conn = connection;
-  if(!conn) {
-    conn = getConnection();
+  PGresult* result = PQgetResult(handle);
+  if(result == nullptr) {
+    return PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR);
   }
 
-  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
-  if(!tr) {
-    tr = m_defaultTypeResolver;
+  /* results of each query are terminated by NULL */
+  PGresult* next;
+  while((next = PQgetResult(handle)) != nullptr) {
+    PQclear(next);
   }
 
-  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(conn.object);
+  return result;
 
-  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
-  bool prepare = extra->prepare;
+}
 
-  if(prepare) {
+void Executor::skipPipelineSync(PGconn* handle) {
+  PGresult* result = PQgetResult(handle);
+  if(result != nullptr) {
+    PQclear(result);
+  }
+}
 
-    if (!pgConnection->isPrepared(extra->templateName)) {
-      auto result = prepareQuery(queryTemplate, tr, conn);
-      if(result->isSuccess()) {
-        pgConnection->setPrepared(extra->templateName);
-      } else {
-        return result;
-      }
-    }
+bool Executor::exitPipeline(PGconn* handle) {
+
+#if defined(LIBPQ_HAS_PIPELINING)
 
-    return executeQueryPrepared(queryTemplate, params, tr, conn);
+  if(PQexitPipelineMode(handle) == 1) {
+    return true;
+  }
+
+  if(!sendPipelineSync(handle) || PQflush(handle) != 0) {
+    return false;
+  }
 
+  /* results of each query are terminated by NULL - two NULLs in a row mean there is nothing left to read */
+  v_int32 nullsInRow = 0;
+  while(PQexitPipelineMode(handle) == 0) {
+    PGresult* result = PQgetResult(handle);
+    if(result == nullptr) {
+      if(++ nullsInRow > 1) {
+        return false;
+      }
+    } else {
+      nullsInRow = 0;
+      PQclear(result);
+    }
   }
 
-  return executeQuery(queryTemplate, params, tr, conn);
+  return true;
+
+#else
+  (void) handle;
+  return true;
+#endif
 
 }
 
-std::shared_ptr<orm::QueryResult> Executor::exec(const oatpp::String& statement,
-                                                 const provider::ResourceHandle<orm::Connection>& connection,
-                                                 bool useExecParams)
-{
+oatpp::String Executor::getDeallocateStatement(const std::vector<oatpp::String>& statementNames, PGconn* handle) {
 
-  auto conn = connection;
-  if(!conn) {
-    conn = getConnection();
-  }
+  std::string result;
 
-  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(conn.object);
+  for(const auto& name : statementNames) {
+    char* escaped = PQescapeIdentifier(handle, name->data(), name->size());
+    if(escaped == nullptr) {
+      continue;
+    }
+    result += "DEALLOCATE ";
+    result += escaped;
+    result += ";";
+    PQfreemem(escaped);
+  }
 
-  PGresult *qres;
-  if(useExecParams) {
-    qres = PQexecParams(pgConnection->getHandle(),
-                        statement->c_str(),
-                        0 /* nParams */,
-                        nullptr /* paramTypes */,
-                        nullptr /* paramValues */,
-                        nullptr /* paramLengths */,
-                        nullptr /* paramFormats */,
-                        1 /* resultFormat */);
-  } else {
-    qres = PQexec(pgConnection->getHandle(), statement->c_str());
+  if(result.empty()) {
+    return nullptr;
   }
 
-  return std::make_shared<QueryResult>(qres, conn, m_resultMapper, m_defaultTypeResolver);
+  return result;
 
 }
 
-std::shared_ptr<orm::QueryResult> Executor::begin(const provider::ResourceHandle<orm::Connection>& connection) {
-  return exec("BEGIN", connection);
-}
+int Executor::sendDeallocate(const std::vector<oatpp::String>& statementNames, PGconn* handle) {
 
-std::shared_ptr<orm::QueryResult> Executor::commit(const provider::ResourceHandle<orm::Connection>& connection) {
-  if(!connection) {
-    throw std::runtime_error("[oatpp::postgresql::Executor::commit()]: "
-                             "Error. Can't COMMIT - NULL connection.");
+  if(statementNames.empty()) {
+    return 1;
   }
-  return exec("COMMIT", connection);
-}
 
-std::shared_ptr<orm::QueryResult> Executor::rollback(const provider::ResourceHandle<orm::Connection>& connection) {
+  for(const auto& name : statementNames) {
+#if defined(LIBPQ_HAS_CLOSE_PREPARED)
+    if(!PQsendClosePrepared(handle, name->c_str())) {
+      return 0;
+    }
+#else
+    auto statement = getDeallocateStatement({name}, handle);
+    if(!statement || !PQsendQueryParams(handle, statement->c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1)) {
+      return 0;
+    }
+#endif
+  }
+
+  /* own sync point - failed deallocate doesn't abort the query */
+  return sendPipelineSync(handle);
+
+}
+
+void Executor::readDeallocate(const std::vector<oatpp::String>& statementNames, Connection& connection) {
+  if(statementNames.empty()) {
+    return;
+  }
+  PGconn* handle = connection.getHandle();
+  for(const auto& name : statementNames) {
+    PGresult* result = getPipelineResult(handle);
+    if(isDeallocated(result)) {
+      connection.setDeallocated(name);
+    }
+    PQclear(result); // failed deallocate is not an error of the query - statement stays tracked and is retried later
+  }
+  skipPipelineSync(handle);
+}
+
+void Executor::deallocateStatements(const std::vector<oatpp::String>& statementNames, Connection& connection) {
+  PGconn* handle = connection.getHandle();
+  /* one by one - so that each statement is untracked only if it was actually deallocated */
+  for(const auto& name : statementNames) {
+    auto statement = getDeallocateStatement({name}, handle);
+    if(!statement) {
+      continue;
+    }
+    PGresult* result = PQexec(handle, statement->c_str());
+    if(isDeallocated(result)) {
+      connection.setDeallocated(name);
+    }
+    PQclear(result);
+  }
+}
+
+bool Executor::isDeallocated(PGresult* result) {
+  if(PQresultStatus(result) == PGRES_COMMAND_OK) {
+    return true;
+  }
+  /* invalid_sql_statement_name - statement doesn't exist on the server */
+  const char* sqlState = PQresultErrorField(result, PG_DIAG_SQLSTATE);
+  return sqlState != nullptr && std::strcmp(sqlState, "26000") == 0;
+}
+
+void Executor::writeCopyField(data::stream::BufferOutputStream& stream, const mapping::Serializer::OutputData& data) {
+  v_int32 size = htonl(data.dataSize);
+  stream.writeSimple(&size, sizeof(v_int32));
+  if(data.dataSize > 0) {
+    stream.writeSimple(data.data, data.dataSize);
+  }
+}
+
+bool Executor::flushCopyData(data::stream::BufferOutputStream& stream, PGconn* handle) {
+  auto size = stream.getCurrentPosition();
+  stream.setCurrentPosition(0);
+  if(size == 0) {
+    return true;
+  }
+  return PQputCopyData(handle, reinterpret_cast<const char*>(stream.getData()), static_cast<int>(size)) == 1;
+}
+
+v_buff_size Executor::readCopyHeader(const char* data, v_buff_size size) {
+
+  static const char signature[] = "PGCOPY\n\377\r\n";
+  static constexpr v_buff_size HEADER_SIZE = sizeof(signature) + 2 * sizeof(v_int32);
+
+  if(size < HEADER_SIZE || std::memcmp(data, signature, sizeof(signature)) != 0) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::readCopyHeader()]: Error. Invalid binary COPY header.");
+  }
+
+  v_int32 extensionSize;
+  std::memcpy(&extensionSize, data + sizeof(signature) + sizeof(v_int32), sizeof(v_int32));
+  extensionSize = ntohl(extensionSize);
+
+  if(extensionSize < 0 || HEADER_SIZE + extensionSize > size) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::readCopyHeader()]: Error. Invalid binary COPY header extension.");
+  }
+
+  return HEADER_SIZE + extensionSize;
+
+}
+
+void Executor::cancelCopyOut(PGconn* handle) {
+
+  PGcancel* cancel = PQgetCancel(handle);
+  if(cancel) {
+    char errorBuffer[256];
+    PQcancel(cancel, errorBuffer, sizeof(errorBuffer));
+    PQfreeCancel(cancel);
+  }
+
+  char* buffer;
+  int size;
+  while((size = PQgetCopyData(handle, &buffer, 0)) > 0) {
+    PQfreemem(buffer);
+  }
+
+}
+
+data::share::StringTemplate Executor::parseQueryTemplate(const oatpp::String& name,
+                                                         const oatpp::String& text,
+                                                         const ParamsTypeMap& paramsTypeMap,
+                                                         bool prepare)
+{
+
+  auto&& t = ql_template::Parser::parseTemplate(text);
+
+  auto extra = std::make_shared<ql_template::Parser::TemplateExtra>();
+  t.setExtraData(extra);
+
+  extra->prepare = prepare;
+  extra->templateName = name;
+  if(prepare && name) {
+    extra->templateId = getTemplateId(name);
+  }
+  extra->paramsTypeMap = paramsTypeMap;
+  extra->bindingPlan = getBindingPlan(t, paramsTypeMap, extra->variableSlots);
+  ql_template::TemplateValueProvider valueProvider(&extra->variableSlots);
+  extra->preparedTemplate = t.format(&valueProvider);
+
+  if(prepare && name) {
+    try {
+      auto paramTypes = getParamTypes(t, paramsTypeMap, m_defaultTypeResolver);
+      auto count = extra->bindingPlan.size();
+      m_preparedTemplatesWarmUp->addStatement(extra->templateId, name, extra->preparedTemplate,
+                                              std::vector<Oid>(paramTypes.get(), paramTypes.get() + count));
+    } catch (const std::runtime_error&) {
+      // Type info is not available (see getParamTypes()). Template will be prepared on its first use.
+    }
+  }
+
+  return t;
+
+}
+
+provider::ResourceHandle<orm::Connection> Executor::getConnection() {
+  auto connection = m_connectionProvider->get();
+  if(connection) {
+    /* set correct invalidator before cast */
+    connection.object->setInvalidator(connection.invalidator);
+    return provider::ResourceHandle<orm::Connection>(
+      connection.object,
+      m_connectionInvalidator
+    );
+  }
+  throw std::runtime_error("[oatpp::postgresql::Executor::getConnection()]: Error. Can't connect.");
+}
+
+std::shared_ptr<orm::QueryResult> Executor::execute(const StringTemplate& queryTemplate,
+                                                    const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                    const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                    const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
+  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
+  if(!tr) {
+    tr = m_defaultTypeResolver;
+  }
+
+  const auto& executionTemplate = getExecutionTemplate(queryTemplate);
+  QueryParams queryParams(executionTemplate, params, m_serializer, tr);
+
+  return executeWithParams(executionTemplate, queryParams, tr, conn, !connection);
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::executePositional(const StringTemplate& queryTemplate,
+                                                              const std::vector<oatpp::Void>& params,
+                                                              const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                              const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
+  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
+  if(!tr) {
+    tr = m_defaultTypeResolver;
+  }
+
+  const auto& executionTemplate = getExecutionTemplate(queryTemplate);
+  QueryParams queryParams(executionTemplate, params, m_serializer);
+
+  return executeWithParams(executionTemplate, queryParams, tr, conn, !connection);
+
+}
+
+std::shared_ptr<QueryResult> Executor::executeWithParams(const StringTemplate& executionTemplate,
+                                                         const QueryParams& queryParams,
+                                                         const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                         const provider::ResourceHandle<orm::Connection>& connection,
+                                                         bool ownConnection)
+{
+
+  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(connection.object);
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(executionTemplate.getExtraData());
+  bool prepare = extra->prepare;
+
+  bool prepareStatement = prepare && !pgConnection->isPrepared(extra->templateId);
+  if(prepare) {
+    pgConnection->recordExecution(extra->templateId, !prepareStatement);
+  }
+  auto deallocate = pgConnection->getEvictedStatements();
+
+  std::shared_ptr<QueryResult> result;
+
+  if(prepareStatement || !deallocate.empty()) {
+    result = executePipelined(executionTemplate, queryParams, typeResolver, connection, prepareStatement, deallocate);
+  } else if(prepare) {
+    result = executeQueryPrepared(queryParams, typeResolver, connection);
+  } else {
+    result = executeQuery(queryParams, typeResolver, connection);
+  }
+
+  if(ownConnection && m_earlyConnectionRelease) {
+    result->releaseConnection();
+  }
+
+  return result;
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::exec(const oatpp::String& statement,
+                                                 const provider::ResourceHandle<orm::Connection>& connection,
+                                                 bool useExecParams)
+{
+
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
+  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(conn.object);
+
+  PGresult *qres;
+  if(useExecParams) {
+    qres = PQexecParams(pgConnection->getHandle(),
+                        statement->c_str(),
+                        0 /* nParams */,
+                        nullptr /* paramTypes */,
+                        nullptr /* paramValues */,
+                        nullptr /* paramLengths */,
+                        nullptr /* paramFormats */,
+                        1 /* resultFormat */);
+  } else {
+    qres = PQexec(pgConnection->getHandle(), statement->c_str());
+  }
+
+  auto result = std::make_shared<QueryResult>(qres, conn, m_resultMapper, m_defaultTypeResolver);
+  if(!connection && m_earlyConnectionRelease) {
+    result->releaseConnection();
+  }
+
+  return result;
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::begin(const provider::ResourceHandle<orm::Connection>& connection) {
+  return exec("BEGIN", connection);
+}
+
+std::shared_ptr<orm::QueryResult> Executor::commit(const provider::ResourceHandle<orm::Connection>& connection) {
+  if(!connection) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::commit()]: "
+                             "Error. Can't COMMIT - NULL connection.");
+  }
+  return exec("COMMIT", connection);
+}
+
+std::shared_ptr<orm::QueryResult> Executor::rollback(const provider::ResourceHandle<orm::Connection>& connection) {
+  if(!connection) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::commit()]: "
+                             "Error. Can't ROLLBACK - NULL connection.");
+  }
+  return exec("ROLLBACK", connection);
+}
+
+std::vector<std::shared_ptr<orm::QueryResult>> Executor::executePipeline(const std::vector<PipelineQuery>& queries,
+                                                                         const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                                         const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+#if defined(LIBPQ_HAS_PIPELINING)
+
+  std::vector<std::shared_ptr<orm::QueryResult>> results;
+  results.reserve(queries.size());
+
+  if(queries.empty()) {
+    return results;
+  }
+
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
+  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
+  if(!tr) {
+    tr = m_defaultTypeResolver;
+  }
+
+  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(conn.object);
+  PGconn* handle = pgConnection->getHandle();
+
+  /* serialize everything before the pipeline is started - so that parameter errors leave the connection untouched */
+
+  std::vector<const StringTemplate*> templates;
+  std::vector<std::unique_ptr<QueryParams>> queryParams;
+  std::vector<std::unique_ptr<Oid[]>> prepareParamTypes;
+  std::unordered_set<v_int64> preparing;
+
+  templates.reserve(queries.size());
+  queryParams.reserve(queries.size());
+  prepareParamTypes.resize(queries.size());
+
+  for(v_uint32 i = 0; i < queries.size(); i ++) {
+    const auto& query = queries[i];
+    const auto& queryTemplate = getExecutionTemplate(query.queryTemplate);
+    auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+    if(extra->prepare) {
+      /* repeated template is prepared once - by its first query in the pipeline */
+      bool prepared = pgConnection->isPrepared(extra->templateId) || preparing.find(extra->templateId) != preparing.end();
+      if(!prepared) {
+        prepareParamTypes[i] = getParamTypes(queryTemplate, extra->paramsTypeMap, tr);
+        preparing.insert(extra->templateId);
+      }
+      pgConnection->recordExecution(extra->templateId, prepared);
+    }
+    templates.push_back(&queryTemplate);
+    queryParams.emplace_back(new QueryParams(queryTemplate, query.params, m_serializer, tr));
+  }
+
+  auto deallocate = pgConnection->getEvictedStatements();
+
+  if(PQenterPipelineMode(handle) == 0) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::executePipeline()]: "
+                             "Error. Can't enter pipeline mode. " + std::string(PQerrorMessage(handle)));
+  }
+
+  v_uint32 sentCount = 0;
+  bool deallocateSent = sendDeallocate(deallocate, handle);
+  bool partialPrepareSent = false;
+
+  for(v_uint32 i = 0; deallocateSent && i < queries.size(); i ++) {
+
+    if(prepareParamTypes[i] && !sendPrepare(*templates[i], prepareParamTypes[i].get(), handle)) {
+      break;
+    }
+
+    auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(templates[i]->getExtraData());
+
+    /* sync point per query - isolate errors */
+    if(!sendQuery(*queryParams[i], extra->prepare, handle) || !sendPipelineSync(handle)) {
+      partialPrepareSent = static_cast<bool>(prepareParamTypes[i]);
+      break;
+    }
+
+    sentCount ++;
+
+  }
+
+  /* close commands of a partially sent query with their own sync point - so that their results can be read */
+  bool partialSynced = false;
+  if(!deallocateSent || sentCount < queries.size()) {
+    partialSynced = sendPipelineSync(handle) == 1;
+  }
+
+  if(PQflush(handle) != 0) {
+    exitPipeline(handle);
+    conn.invalidator->invalidate(conn.object);
+    throw std::runtime_error("[oatpp::postgresql::Executor::executePipeline()]: "
+                             "Error. Can't send pipeline. " + std::string(PQerrorMessage(handle)));
+  }
+
+  if(deallocateSent) {
+    readDeallocate(deallocate, *pgConnection);
+  }
+
+  std::vector<std::shared_ptr<QueryResult>> pgResults;
+  pgResults.reserve(queries.size());
+
+  for(v_uint32 i = 0; i < sentCount; i ++) {
+
+    PGresult* prepareResult = nullptr;
+    if(prepareParamTypes[i]) {
+      prepareResult = getPipelineResult(handle);
+    }
+
+    PGresult* qres = getPipelineResult(handle);
+    skipPipelineSync(handle);
+
+    if(prepareResult != nullptr) {
+      if(PQresultStatus(prepareResult) == PGRES_COMMAND_OK) {
+        auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(templates[i]->getExtraData());
+        pgConnection->setPrepared(extra->templateId, extra->templateName);
+        PQclear(prepareResult);
+      } else {
+        /* query was aborted - report the reason */
+        PQclear(qres);
+        qres = prepareResult;
+      }
+    }
+
+    pgResults.push_back(std::make_shared<QueryResult>(qres, conn, m_resultMapper, tr));
+
+  }
+
+  /* statement may be created on the server even though its query failed to be sent - keep track of it */
+  if(partialPrepareSent && partialSynced) {
+    PGresult* prepareResult = getPipelineResult(handle);
+    if(PQresultStatus(prepareResult) == PGRES_COMMAND_OK) {
+      auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(templates[sentCount]->getExtraData());
+      pgConnection->setPrepared(extra->templateId, extra->templateName);
+    }
+    PQclear(prepareResult);
+  }
+
+  /* queries which failed to be sent */
+  for(v_uint32 i = sentCount; i < queries.size(); i ++) {
+    pgResults.push_back(std::make_shared<QueryResult>(PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR), conn, m_resultMapper, tr));
+  }
+
+  if(!exitPipeline(handle)) {
+    conn.invalidator->invalidate(conn.object);
+    throw std::runtime_error("[oatpp::postgresql::Executor::executePipeline()]: "
+                             "Error. Can't exit pipeline mode. " + std::string(PQerrorMessage(handle)));
+  }
+
+  for(auto& result : pgResults) {
+    if(!connection && m_earlyConnectionRelease) {
+      result->releaseConnection();
+    }
+    results.push_back(result);
+  }
+
+  return results;
+
+#else
+
+  (void) queries;
+  (void) typeResolver;
+  (void) connection;
+
+  throw std::runtime_error("[oatpp::postgresql::Executor::executePipeline()]: "
+                           "Error. Pipeline mode is not supported by this version of libpq.");
+
+#endif
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::executeBatch(const StringTemplate& queryTemplate,
+                                                         const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& batch,
+                                                         const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                         const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  if(batch.empty()) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::executeBatch()]: Error. Empty batch.");
+  }
+
+  /* transpose parameter sets into columns - each column is serialized as a PostgreSQL array */
+  std::unordered_map<oatpp::String, oatpp::Void> params;
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+
+  for(v_uint32 i = 0; i < extra->bindingPlan.size(); i ++) {
+
+    const auto& binding = extra->bindingPlan[i];
+    if(!binding.propertyPath.empty()) {
+      throw std::runtime_error("[oatpp::postgresql::Executor::executeBatch()]: "
+                               "Error. Property paths are not supported in batch parameters - " +
+                               *binding.variableName);
+    }
+
+    if(params.find(binding.paramName) != params.end()) {
+      continue;
+    }
+
+    oatpp::Vector<oatpp::Void> column({});
+    column->reserve(batch.size());
+
+    for(const auto& paramsSet : batch) {
+      auto it = paramsSet.find(binding.paramName);
+      if(it == paramsSet.end()) {
+        throw std::runtime_error("[oatpp::postgresql::Executor::executeBatch()]: "
+                                 "Error. Parameter not found " + *binding.paramName);
+      }
+      if(it->second.getValueType()->isCollection) {
+        throw std::runtime_error("[oatpp::postgresql::Executor::executeBatch()]: "
+                                 "Error. Collections are not supported as batch parameter values - " + *binding.paramName);
+      }
+      column->push_back(it->second);
+    }
+
+    params.insert({binding.paramName, column});
+
+  }
+
+  return execute(queryTemplate, params, typeResolver, connection);
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::executeStreaming(const StringTemplate& queryTemplate,
+                                                             const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                             v_int32 chunkSize,
+                                                             const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                             const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
+  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
+  if(!tr) {
+    tr = m_defaultTypeResolver;
+  }
+
+  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(conn.object);
+  PGconn* handle = pgConnection->getHandle();
+
+  const auto& executionTemplate = getExecutionTemplate(queryTemplate);
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(executionTemplate.getExtraData());
+
+  QueryParams queryParams(executionTemplate, params, m_serializer, tr);
+
+  bool prepareStatement = extra->prepare && !pgConnection->isPrepared(extra->templateId);
+  if(extra->prepare) {
+    pgConnection->recordExecution(extra->templateId, !prepareStatement);
+  }
+
+  deallocateStatements(pgConnection->getEvictedStatements(), *pgConnection);
+
+  if(prepareStatement) {
+    auto result = prepareQuery(executionTemplate, tr, conn);
+    if(!result->isSuccess()) {
+      return result;
+    }
+    pgConnection->setPrepared(extra->templateId, extra->templateName);
+  }
+
+  if(!sendQuery(queryParams, extra->prepare, handle)) {
+    return std::make_shared<QueryResult>(PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR), conn, m_resultMapper, tr);
+  }
+
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+  if(chunkSize > 1) {
+    PQsetChunkedRowsMode(handle, chunkSize);
+  } else {
+    PQsetSingleRowMode(handle);
+  }
+#else
+  (void) chunkSize;
+  PQsetSingleRowMode(handle);
+#endif
+
+  PGresult* first = PQgetResult(handle);
+  if(first == nullptr) {
+    first = PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR);
+  }
+
+  switch(PQresultStatus(first)) {
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+    case PGRES_TUPLES_CHUNK:
+#endif
+    case PGRES_SINGLE_TUPLE:
+      /* rows are pulled by the QueryResult - the connection stays with the result */
+      return std::make_shared<QueryResult>(first, conn, m_resultMapper, tr);
+    default:
+      break;
+  }
+
+  /* empty result set, command or error - the result is complete */
+  PGresult* next;
+  while((next = PQgetResult(handle)) != nullptr) {
+    PQclear(next);
+  }
+
+  auto result = std::make_shared<QueryResult>(first, conn, m_resultMapper, tr);
+  if(!connection && m_earlyConnectionRelease) {
+    result->releaseConnection();
+  }
+
+  return result;
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::executeCursor(const StringTemplate& queryTemplate,
+                                                          const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                          v_int64 fetchSize,
+                                                          const provider::ResourceHandle<orm::Connection>& connection,
+                                                          const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver)
+{
+
+  if(!connection) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::executeCursor()]: "
+                             "Error. Can't declare cursor - NULL connection.");
+  }
+
+  if(fetchSize <= 0) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::executeCursor()]: "
+                             "Error. Invalid fetchSize. fetchSize must be > 0.");
+  }
+
+  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(connection.object);
+  PGconn* handle = pgConnection->getHandle();
+
+  if(PQtransactionStatus(handle) != PQTRANS_INTRANS) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::executeCursor()]: "
+                             "Error. Can't declare cursor - connection is not in a transaction.");
+  }
+
+  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
+  if(!tr) {
+    tr = m_defaultTypeResolver;
+  }
+
+  auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+  QueryParams queryParams(queryTemplate, params, m_serializer, tr);
+
+  static std::atomic<v_int64> cursorsCounter(0);
+  oatpp::String cursorName = "oatpp_cursor_" + std::to_string(cursorsCounter ++);
+
+  std::string declare = "DECLARE " + *cursorName + " NO SCROLL CURSOR FOR " + *extra->preparedTemplate;
+
+  PGresult* qres = PQexecParams(handle,
+                                declare.c_str(),
+                                queryParams.count,
+                                queryParams.paramOids,
+                                queryParams.paramValues,
+                                queryParams.paramLengths,
+                                queryParams.paramFormats,
+                                1);
+
+  if(PQresultStatus(qres) != PGRES_COMMAND_OK) {
+    return std::make_shared<QueryResult>(qres, connection, m_resultMapper, tr);
+  }
+  PQclear(qres);
+
+  std::string fetch = "FETCH FORWARD " + std::to_string(fetchSize) + " FROM " + *cursorName;
+  qres = PQexecParams(handle, fetch.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
+
+  return std::make_shared<QueryResult>(qres, connection, m_resultMapper, tr, cursorName, fetchSize);
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::copyIn(const oatpp::String& tableName,
+                                                   const oatpp::Type* rowType,
+                                                   const CopyInRowProducer& rowProducer,
+                                                   const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  static constexpr v_buff_size COPY_PORTION_SIZE = 64 * 1024;
+
+  if(rowType == nullptr || rowType->classId.id != data::type::__class::AbstractObject::CLASS_ID.id) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::copyIn()]: "
+                             "Error. Invalid rowType. rowType must be an oatpp::Object.");
+  }
+
+  auto dispatcher = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(rowType->polymorphicDispatcher);
+  const auto& properties = dispatcher->getProperties()->getList();
+
+  if(properties.empty()) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::copyIn()]: "
+                             "Error. The object of type " + std::string(rowType->nameQualifier) + " has no fields.");
+  }
+
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
+  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(conn.object);
+  PGconn* handle = pgConnection->getHandle();
+
+  std::string statement = "COPY " + *tableName + " (";
+  bool first = true;
+  for(auto property : properties) {
+    char* column = PQescapeIdentifier(handle, property->name, std::strlen(property->name));
+    if(column == nullptr) {
+      throw std::runtime_error("[oatpp::postgresql::Executor::copyIn()]: "
+                               "Error. Can't escape column name '" + std::string(property->name) + "'. " + PQerrorMessage(handle));
+    }
+    if(!first) {
+      statement += ", ";
+    }
+    first = false;
+    statement += column;
+    PQfreemem(column);
+  }
+  statement += ") FROM STDIN (FORMAT binary)";
+
+  PGresult* qres = PQexec(handle, statement.c_str());
+  if(PQresultStatus(qres) != PGRES_COPY_IN) {
+    auto result = std::make_shared<QueryResult>(qres, conn, m_resultMapper, m_defaultTypeResolver);
+    if(!connection && m_earlyConnectionRelease) {
+      result->releaseConnection();
+    }
+    return result;
+  }
+  PQclear(qres);
+
+  data::stream::BufferOutputStream stream(COPY_PORTION_SIZE + 4096);
+
+  /* signature, flags field, header extension length */
+  static const char signature[] = "PGCOPY\n\377\r\n";
+  stream.writeSimple(signature, sizeof(signature));
+  v_int32 zero = 0;
+  stream.writeSimple(&zero, sizeof(v_int32));
+  stream.writeSimple(&zero, sizeof(v_int32));
+
+  std::exception_ptr exception;
+  bool sent = true;
+
+  try {
+
+    v_int16 fieldsCount = htons(static_cast<v_int16>(properties.size()));
+
+    while(sent) {
+
+      auto row = rowProducer();
+      if(!row) {
+        break;
+      }
+
+      auto object = static_cast<oatpp::BaseObject*>(row.get());
+
+      stream.writeSimple(&fieldsCount, sizeof(v_int16));
+      for(auto property : properties) {
+        mapping::Serializer::OutputData data;
+        m_serializer.serialize(data, property->get(object));
+        writeCopyField(stream, data);
+      }
+
+      if(stream.getCurrentPosition() >= COPY_PORTION_SIZE) {
+        sent = flushCopyData(stream, handle);
+      }
+
+    }
+
+    if(sent) {
+      v_int16 trailer = htons(static_cast<v_int16>(-1));
+      stream.writeSimple(&trailer, sizeof(v_int16));
+      sent = flushCopyData(stream, handle);
+    }
+
+  } catch (...) {
+    exception = std::current_exception();
+  }
+
+  PQputCopyEnd(handle, exception ? "COPY aborted by the client" : nullptr);
+
+  PGresult* last = PQgetResult(handle);
+  if(last == nullptr) {
+    last = PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR);
+  }
+  PGresult* next;
+  while((next = PQgetResult(handle)) != nullptr) {
+    PQclear(next);
+  }
+
+  auto result = std::make_shared<QueryResult>(last, conn, m_resultMapper, m_defaultTypeResolver);
+  if(!connection && m_earlyConnectionRelease) {
+    result->releaseConnection();
+  }
+
+  if(exception) {
+    std::rethrow_exception(exception);
+  }
+
+  return result;
+
+}
+
+std::shared_ptr<orm::QueryResult> Executor::copyOut(const oatpp::String& query,
+                                                    const oatpp::Type* rowType,
+                                                    const CopyOutRowConsumer& rowConsumer,
+                                                    const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                    const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
+  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
+  if(!tr) {
+    tr = m_defaultTypeResolver;
+  }
+
+  auto pgConnection = std::static_pointer_cast<postgresql::Connection>(conn.object);
+  PGconn* handle = pgConnection->getHandle();
+
+  auto releaseEarly = [&](const std::shared_ptr<QueryResult>& result) -> std::shared_ptr<QueryResult> {
+    if(!connection && m_earlyConnectionRelease) {
+      result->releaseConnection();
+    }
+    return result;
+  };
+
+  auto fail = [&](PGresult* errorResult) -> std::shared_ptr<QueryResult> {
+    if(errorResult == nullptr) {
+      errorResult = PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR);
+    }
+    PGresult* next;
+    while((next = PQgetResult(handle)) != nullptr) {
+      PQclear(next);
+    }
+    return releaseEarly(std::make_shared<QueryResult>(errorResult, conn, m_resultMapper, tr));
+  };
+
+  /*
+   * Binary COPY carries no type information - column names and types are taken from the empty result of
+   * the LIMIT 0 query. Both statements go in a single simple query message - one round trip.
+   */
+  std::string statement = "SELECT * FROM (" + *query + ") AS oatpp_copy_out LIMIT 0; "
+                          "COPY (" + *query + ") TO STDOUT (FORMAT binary)";
+
+  if(!PQsendQuery(handle, statement.c_str())) {
+    return fail(nullptr);
+  }
+
+  PGresult* description = PQgetResult(handle);
+  if(description == nullptr || PQresultStatus(description) != PGRES_TUPLES_OK) {
+    return fail(description);
+  }
+  std::unique_ptr<PGresult, void(*)(PGresult*)> descriptionGuard(description, PQclear);
+
+  PGresult* qres = PQgetResult(handle);
+  if(qres == nullptr || PQresultStatus(qres) != PGRES_COPY_OUT) {
+    return fail(qres);
+  }
+  PQclear(qres);
+
+  mapping::ResultMapper::ResultData dbData(description, tr);
+
+  std::vector<mapping::Deserializer::InData> tuple(dbData.colCount);
+  for(v_int32 i = 0; i < dbData.colCount; i ++) {
+    tuple[i].typeResolver = tr.get();
+    tuple[i].oid = PQftype(description, i);
+  }
+  dbData.copyTuple = &tuple;
+
+  std::exception_ptr exception;
+  bool headerRead = false;
+  char* buffer;
+  int size;
+
+  while((size = PQgetCopyData(handle, &buffer, 0)) > 0) {
+
+    std::unique_ptr<char, void(*)(void*)> message(buffer, PQfreemem);
+
+    try {
+
+      v_buff_size pos = 0;
+      if(!headerRead) {
+        pos = readCopyHeader(buffer, size);
+        headerRead = true;
+      }
+
+      while(pos + static_cast<v_buff_size>(sizeof(v_int16)) <= size) {
+
+        v_int16 fieldsCount;
+        std::memcpy(&fieldsCount, buffer + pos, sizeof(v_int16));
+        fieldsCount = static_cast<v_int16>(ntohs(static_cast<v_uint16>(fieldsCount)));
+        pos += sizeof(v_int16);
+
+        if(fieldsCount == -1) {
+          break; // trailer
+        }
+
+        if(fieldsCount != dbData.colCount) {
+          throw std::runtime_error("[oatpp::postgresql::Executor::copyOut()]: Error. Unexpected number of fields in tuple.");
+        }
+
+        for(v_int32 i = 0; i < fieldsCount; i ++) {
+
+          if(pos + static_cast<v_buff_size>(sizeof(v_int32)) > size) {
+            throw std::runtime_error("[oatpp::postgresql::Executor::copyOut()]: Error. Truncated tuple.");
+          }
+
+          v_int32 fieldSize;
+          std::memcpy(&fieldSize, buffer + pos, sizeof(v_int32));
+          fieldSize = static_cast<v_int32>(ntohl(static_cast<v_uint32>(fieldSize)));
+          pos += sizeof(v_int32);
+
+          auto& field = tuple[i];
+          if(fieldSize < 0) {
+            field.isNull = true;
+            field.data = nullptr;
+            field.size = 0;
+          } else {
+            if(pos + fieldSize > size) {
+              throw std::runtime_error("[oatpp::postgresql::Executor::copyOut()]: Error. Truncated tuple.");
+            }
+            field.isNull = false;
+            field.data = buffer + pos;
+            field.size = fieldSize;
+            pos += fieldSize;
+          }
+
+        }
+
+        rowConsumer(m_resultMapper->readOneRow(&dbData, rowType, 0));
+
+      }
+
+    } catch (...) {
+      exception = std::current_exception();
+      message.reset();
+      cancelCopyOut(handle);
+      break;
+    }
+
+  }
+
+  PGresult* last = PQgetResult(handle);
+  if(last == nullptr) {
+    last = PQmakeEmptyPGresult(handle, PGRES_FATAL_ERROR);
+  }
+  PGresult* next;
+  while((next = PQgetResult(handle)) != nullptr) {
+    PQclear(next);
+  }
+
+  auto result = releaseEarly(std::make_shared<QueryResult>(last, conn, m_resultMapper, tr));
+
+  if(exception) {
+    std::rethrow_exception(exception);
+  }
+
+  return result;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// PreparedTemplatesWarmUp
+
+void Executor::PreparedTemplatesWarmUp::addStatement(v_int64 id,
+                                                     const oatpp::String& name,
+                                                     const oatpp::String& text,
+                                                     std::vector<Oid>&& paramTypes)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for(const auto& statement : m_statements) {
+    if(statement.id == id) {
+      return;
+    }
+  }
+  m_statements.push_back({id, name, text, std::move(paramTypes)});
+}
+
+std::vector<Executor::PreparedTemplatesWarmUp::Statement> Executor::PreparedTemplatesWarmUp::getStatements() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_statements;
+}
+
+void Executor::PreparedTemplatesWarmUp::warmUp(const std::shared_ptr<Connection>& connection) {
+
+  auto statements = getStatements();
+  if(statements.empty()) {
+    return;
+  }
+
+  PGconn* handle = connection->getHandle();
+
+#if defined(LIBPQ_HAS_PIPELINING)
+
+  if(PQenterPipelineMode(handle) == 0) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::PreparedTemplatesWarmUp::warmUp()]: "
+                             "Error. Can't enter pipeline mode. " + std::string(PQerrorMessage(handle)));
+  }
+
+  bool sent = true;
+  for(const auto& statement : statements) {
+    if(!PQsendPrepare(handle, statement.name->c_str(), statement.text->c_str(),
+                      statement.paramTypes.size(), statement.paramTypes.data()) ||
+       !sendPipelineSync(handle))
+    {
+      sent = false;
+      break;
+    }
+  }
+
+  if(!sent || PQflush(handle) != 0) {
+    exitPipeline(handle);
+    throw std::runtime_error("[oatpp::postgresql::Executor::PreparedTemplatesWarmUp::warmUp()]: "
+                             "Error. Can't send statements. " + std::string(PQerrorMessage(handle)));
+  }
+
+  for(const auto& statement : statements) {
+    PGresult* result = getPipelineResult(handle);
+    if(PQresultStatus(result) == PGRES_COMMAND_OK) {
+      connection->setPrepared(statement.id, statement.name);
+    }
+    PQclear(result);
+    skipPipelineSync(handle);
+  }
+
+  if(!exitPipeline(handle)) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::PreparedTemplatesWarmUp::warmUp()]: "
+                             "Error. Can't exit pipeline mode. " + std::string(PQerrorMessage(handle)));
+  }
+
+#else
+
+  for(const auto& statement : statements) {
+    PGresult* result = PQprepare(handle, statement.name->c_str(), statement.text->c_str(),
+                                 statement.paramTypes.size(), statement.paramTypes.data());
+    if(PQresultStatus(result) == PGRES_COMMAND_OK) {
+      connection->setPrepared(statement.id, statement.name);
+    }
+    PQclear(result);
+  }
+
+#endif
+
+}
+
+async::CoroutineStarter Executor::PreparedTemplatesWarmUp::warmUpAsync(const std::shared_ptr<Connection>& connection) {
+
+  class WarmUpCoroutine : public async::Coroutine<WarmUpCoroutine> {
+  private:
+    std::shared_ptr<Connection> m_connection;
+    std::vector<Statement> m_statements;
+    v_uint32 m_doneCount;
+  private:
+
+    /* connection is not handed out on error - no need to leave pipeline mode */
+    Action onError(const std::string& message) {
+      PGconn* handle = m_connection->getHandle();
+      return error<async::Error>("[oatpp::postgresql::Executor::PreparedTemplatesWarmUp::warmUpAsync()]: "
+                                 "Error. " + message + " " + std::string(PQerrorMessage(handle)));
+    }
+
+  public:
+
+    WarmUpCoroutine(const std::shared_ptr<Connection>& connection, std::vector<Statement>&& statements)
+      : m_connection(connection)
+      , m_statements(std::move(statements))
+      , m_doneCount(0)
+    {}
+
+    Action act() override {
+
+#if defined(LIBPQ_HAS_PIPELINING)
+
+      if(m_statements.empty()) {
+        return finish();
+      }
+
+      PGconn* handle = m_connection->getHandle();
+
+      if(PQsetnonblocking(handle, 1) != 0 || PQenterPipelineMode(handle) == 0) {
+        return error<async::Error>("[oatpp::postgresql::Executor::PreparedTemplatesWarmUp::warmUpAsync()]: "
+                                   "Error. Can't enter pipeline mode. " + std::string(PQerrorMessage(handle)));
+      }
+
+      for(const auto& statement : m_statements) {
+        if(!PQsendPrepare(handle, statement.name->c_str(), statement.text->c_str(),
+                          statement.paramTypes.size(), statement.paramTypes.data()) ||
+           !sendPipelineSync(handle))
+        {
+          return onError("Can't send statements.");
+        }
+      }
+
+      return yieldTo(&WarmUpCoroutine::flush);
+
+#else
+      return finish(); // statements will be prepared on their first use
+#endif
+
+    }
+
+    Action flush() {
+      PGconn* handle = m_connection->getHandle();
+      switch(PQflush(handle)) {
+        case 0:
+          return yieldTo(&WarmUpCoroutine::read);
+        case 1:
+          /* IO wait action waits for one direction only - drain incoming data and retry the flush shortly */
+          if(PQconsumeInput(handle) == 0) {
+            return onError("Can't send statements.");
+          }
+          return Action::createWaitRepeatAction(oatpp::Environment::getMicroTickCount() + 1000);
+        default:
+          return onError("Can't send statements.");
+      }
+    }
+
+    Action read() {
+
+      PGconn* handle = m_connection->getHandle();
+
+      if(PQconsumeInput(handle) == 0) {
+        return onError("Can't read results.");
+      }
+
+      while(!PQisBusy(handle)) {
+
+        PGresult* result = PQgetResult(handle);
+        if(result == nullptr) {
+          continue; // end of results of one statement
+        }
+
+        auto status = PQresultStatus(result);
+        if(status == PGRES_COMMAND_OK) {
+          m_connection->setPrepared(m_statements[m_doneCount].id, m_statements[m_doneCount].name);
+        }
+        PQclear(result);
+
+#if defined(LIBPQ_HAS_PIPELINING)
+        if(status == PGRES_PIPELINE_SYNC) {
+          m_doneCount ++;
+          if(m_doneCount == m_statements.size()) {
+            return yieldTo(&WarmUpCoroutine::done);
+          }
+        }
+#endif
+
+      }
+
+      return Action::createIOWaitAction(PQsocket(handle), Action::IOEventType::IO_EVENT_READ);
+
+    }
+
+    Action done() {
+      PGconn* handle = m_connection->getHandle();
+      if(!exitPipeline(handle)) {
+        return error<async::Error>("[oatpp::postgresql::Executor::PreparedTemplatesWarmUp::warmUpAsync()]: "
+                                   "Error. Can't exit pipeline mode. " + std::string(PQerrorMessage(handle)));
+      }
+      if(PQsetnonblocking(handle, 0) != 0) {
+        return error<async::Error>("[oatpp::postgresql::Executor::PreparedTemplatesWarmUp::warmUpAsync()]: "
+                                   "Error. Can't switch connection to blocking mode. " + std::string(PQerrorMessage(handle)));
+      }
+      return finish();
+    }
+
+  };
+
+  return WarmUpCoroutine::start(connection, getStatements());
+
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Async
+
+class Executor::QueryCoroutine : public async::CoroutineWithResult<QueryCoroutine, const std::shared_ptr<orm::QueryResult>&> {
+private:
+  static constexpr v_int32 STAGE_PREPARE = 0;
+  static constexpr v_int32 STAGE_EXECUTE = 1;
+  static constexpr v_int32 STAGE_PIPELINE = 2;
+  static constexpr v_int32 STAGE_DEALLOCATE = 3;
+private:
+  /* not owned - executor must outlive the coroutine. See Executor::executeAsync() */
+  Executor* m_executor;
+  std::shared_ptr<StringTemplate> m_queryTemplate;
+  oatpp::String m_statement;
+  std::unordered_map<oatpp::String, oatpp::Void> m_params;
+  std::shared_ptr<const data::mapping::TypeResolver> m_typeResolver;
+  provider::ResourceHandle<orm::Connection> m_connection;
+  PGresult* m_result;
+  PGresult* m_prepareResult;
+  std::vector<oatpp::String> m_deallocate;
+  v_uint32 m_deallocateDone;
+  v_int32 m_stage;
+  v_int32 m_queriesDone;
+  v_int32 m_syncsDone;
+  bool m_prepareSent;
+  bool m_deallocateSent;
+  bool m_deallocateTaken;
+  bool m_connectionAcquired;
+  bool m_inProgress;
+private:
+
+  PGconn* getHandle() {
+    return std::static_pointer_cast<Connection>(m_connection.object)->getHandle();
+  }
+
+  void keepResult(PGresult* result) {
+    if(m_result == nullptr) {
+      m_result = result;
+    } else if(PQresultStatus(m_result) == PGRES_FATAL_ERROR) {
+      PQclear(result); // keep the first error
+    } else {
+      PQclear(m_result);
+      m_result = result;
+    }
+  }
+
+public:
+
+  QueryCoroutine(Executor* executor,
+                 const std::shared_ptr<StringTemplate>& queryTemplate,
+                 const oatpp::String& statement,
+                 const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                 const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                 const provider::ResourceHandle<orm::Connection>& connection)
+    : m_executor(executor)
+    , m_queryTemplate(queryTemplate)
+    , m_statement(statement)
+    , m_params(params)
+    , m_typeResolver(typeResolver)
+    , m_connection(connection)
+    , m_result(nullptr)
+    , m_prepareResult(nullptr)
+    , m_deallocateDone(0)
+    , m_stage(STAGE_EXECUTE)
+    , m_queriesDone(0)
+    , m_syncsDone(0)
+    , m_prepareSent(false)
+    , m_deallocateSent(false)
+    , m_deallocateTaken(false)
+    , m_connectionAcquired(false)
+    , m_inProgress(false)
+  {}
+
+  ~QueryCoroutine() override {
+    if(m_result != nullptr) {
+      PQclear(m_result);
+    }
+    if(m_prepareResult != nullptr) {
+      PQclear(m_prepareResult);
+    }
+    if(m_inProgress) {
+      /* coroutine was aborted while query is in progress - the connection is in unknown state */
+      m_connection.invalidator->invalidate(m_connection.object);
+    }
+  }
+
+  Action act() override {
+    if(!m_connection) {
+      return m_executor->getConnectionAsync().callbackTo(&QueryCoroutine::onConnection);
+    }
+    return yieldTo(&QueryCoroutine::send);
+  }
+
+  Action onConnection(const provider::ResourceHandle<orm::Connection>& connection) {
+    m_connection = connection;
+    m_connectionAcquired = true;
+    return yieldTo(&QueryCoroutine::send);
+  }
+
+  Action send() {
+
+    auto pgConnection = std::static_pointer_cast<Connection>(m_connection.object);
+    PGconn* handle = pgConnection->getHandle();
+
+    if(!m_inProgress) {
+      if(PQsetnonblocking(handle, 1) != 0) {
+        return onConnectionError();
+      }
+      m_inProgress = true;
+    }
+
+    int sent;
+
+    try {
+
+      if(m_queryTemplate) {
+
+        auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(m_queryTemplate->getExtraData());
+
+        bool prepareStatement = extra->prepare && !pgConnection->isPrepared(extra->templateId);
+
+        std::unique_ptr<Oid[]> paramTypes;
+        if(prepareStatement) {
+          paramTypes = m_executor->getParamTypes(*m_queryTemplate, extra->paramsTypeMap, m_typeResolver);
+        }
+        QueryParams queryParams(*m_queryTemplate, m_params, m_executor->m_serializer, m_typeResolver);
+
+        if(!m_deallocateTaken) {
+          /* first round - send() is repeated after deallocate and prepare stages */
+          if(extra->prepare) {
+            pgConnection->recordExecution(extra->templateId, !prepareStatement);
+          }
+          m_deallocate = pgConnection->getEvictedStatements();
+          m_deallocateTaken = true;
+        }
+
+#if defined(LIBPQ_HAS_PIPELINING)
+
+        if(prepareStatement || !m_deallocate.empty()) {
+          /* Deallocate of evicted statements, Parse, Bind/Execute and Syncs go to the server in a single flush */
+          m_stage = STAGE_PIPELINE;
+          m_prepareSent = prepareStatement;
+          m_deallocateSent = !m_deallocate.empty();
+          sent = PQenterPipelineMode(handle) &&
+                 sendDeallocate(m_deallocate, handle) &&
+                 (!prepareStatement || sendPrepare(*m_queryTemplate, paramTypes.get(), handle)) &&
+                 sendQuery(queryParams, extra->prepare, handle) &&
+                 sendPipelineSync(handle);
+        }
+#else
+        if(m_deallocateDone < m_deallocate.size()) {
+          /* one by one - so that each statement is untracked only if it was actually deallocated */
+          m_stage = STAGE_DEALLOCATE;
+          auto statement = getDeallocateStatement({m_deallocate[m_deallocateDone]}, handle);
+          sent = statement ? PQsendQuery(handle, statement->c_str()) : 0;
+        } else if(prepareStatement) {
+          m_stage = STAGE_PREPARE;
+          sent = sendPrepare(*m_queryTemplate, paramTypes.get(), handle);
+        }
+#endif
+        else {
+          m_stage = STAGE_EXECUTE;
+          sent = sendQuery(queryParams, extra->prepare, handle);
+        }
+
+      } else {
+        m_stage = STAGE_EXECUTE;
+        sent = PQsendQuery(handle, m_statement->c_str());
+      }
+
+    } catch (std::exception& e) {
+      PQsetnonblocking(handle, 0);
+      m_inProgress = false;
+      return error<async::Error>(e.what());
+    }
+
+    if(!sent) {
+      return onConnectionError();
+    }
+
+    return yieldTo(&QueryCoroutine::flush);
+
+  }
+
+  Action flush() {
+    PGconn* handle = getHandle();
+    switch(PQflush(handle)) {
+      case 0:
+        return yieldTo(&QueryCoroutine::read);
+      case 1:
+        /*
+         * Socket has to become either read- or write-ready. IO wait action waits for one direction only -
+         * waiting for write alone deadlocks if the server is blocked on sending us results.
+         * Drain incoming data and retry the flush shortly.
+         */
+        if(PQconsumeInput(handle) == 0) {
+          return onConnectionError();
+        }
+        return Action::createWaitRepeatAction(oatpp::Environment::getMicroTickCount() + 1000);
+      default:
+        return onConnectionError();
+    }
+  }
+
+  Action read() {
+
+    PGconn* handle = getHandle();
+
+    if(PQconsumeInput(handle) == 0) {
+      return onConnectionError();
+    }
+
+    while(!PQisBusy(handle)) {
+
+      PGresult* result = PQgetResult(handle);
+
+      if(m_stage == STAGE_PIPELINE) {
+
+        /* pipeline: [deallocate results, sync], [prepare results, NULL], query results, NULL, sync */
+        bool deallocating = m_deallocateSent && m_syncsDone == 0;
+
+        if(result == nullptr) {
+          if(!deallocating) {
+            m_queriesDone ++;
+          }
+        } else if(PQresultStatus(result) == PGRES_PIPELINE_SYNC) {
+          PQclear(result);
+          m_syncsDone ++;
+          if(!deallocating) {
+            return yieldTo(&QueryCoroutine::onResult);
+          }
+        } else if(deallocating) {
+          if(m_deallocateDone < m_deallocate.size() && isDeallocated(result)) {
+            std::static_pointer_cast<Connection>(m_connection.object)->setDeallocated(m_deallocate[m_deallocateDone]);
+          }
+          m_deallocateDone ++;
+          PQclear(result); // failed deallocate is not an error of the query - statement stays tracked
+        } else if(m_prepareSent && m_queriesDone == 0 && m_prepareResult == nullptr) {
+          m_prepareResult = result;
+        } else if(m_prepareSent && m_queriesDone == 0) {
+          PQclear(result);
+        } else {
+          keepResult(result);
+        }
+
+      } else {
+
+        if(result == nullptr) {
+          return yieldTo(&QueryCoroutine::onResult);
+        }
+        keepResult(result);
+
+      }
+
+    }
+
+    return Action::createIOWaitAction(PQsocket(handle), Action::IOEventType::IO_EVENT_READ);
+
+  }
+
+  Action onResult() {
+
+#if defined(LIBPQ_HAS_PIPELINING)
+    if(m_stage == STAGE_PIPELINE) {
+
+      if(!exitPipeline(getHandle())) {
+        /* connection is left in pipeline mode - fail the query so that the connection is invalidated */
+        if(m_prepareResult != nullptr) {
+          PQclear(m_prepareResult);
+          m_prepareResult = nullptr;
+        }
+        return onConnectionError();
+      }
+
+      if(m_prepareResult != nullptr && PQresultStatus(m_prepareResult) == PGRES_COMMAND_OK) {
+        auto pgConnection = std::static_pointer_cast<Connection>(m_connection.object);
+        auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(m_queryTemplate->getExtraData());
+        pgConnection->setPrepared(extra->templateId, extra->templateName);
+        PQclear(m_prepareResult);
+      } else if(m_prepareResult != nullptr) {
+        /* execution was aborted - report the reason */
+        if(m_result != nullptr) {
+          PQclear(m_result);
+        }
+        m_result = m_prepareResult;
+      }
+
+      m_prepareResult = nullptr;
+
+    }
+#endif
+
+    if(m_stage == STAGE_DEALLOCATE) {
+      if(m_result != nullptr) {
+        if(isDeallocated(m_result)) {
+          std::static_pointer_cast<Connection>(m_connection.object)->setDeallocated(m_deallocate[m_deallocateDone]);
+        }
+        PQclear(m_result); // failed deallocate is not an error of the query - statement stays tracked
+        m_result = nullptr;
+      }
+      m_deallocateDone ++;
+      return yieldTo(&QueryCoroutine::send);
+    }
+
+    if(m_result == nullptr) {
+      m_result = PQmakeEmptyPGresult(getHandle(), PGRES_FATAL_ERROR);
+    }
+
+    if(m_stage == STAGE_PREPARE && PQresultStatus(m_result) == PGRES_COMMAND_OK) {
+      auto pgConnection = std::static_pointer_cast<Connection>(m_connection.object);
+      auto extra = std::static_pointer_cast<ql_template::Parser::TemplateExtra>(m_queryTemplate->getExtraData());
+      pgConnection->setPrepared(extra->templateId, extra->templateName);
+      PQclear(m_result);
+      m_result = nullptr;
+      return yieldTo(&QueryCoroutine::send);
+    }
+
+    return finish();
+
+  }
+
+  Action onConnectionError() {
+    keepResult(PQmakeEmptyPGresult(getHandle(), PGRES_FATAL_ERROR));
+    return finish();
+  }
+
+  Action finish() {
+
+    if(m_inProgress) {
+      PQsetnonblocking(getHandle(), 0);
+      m_inProgress = false;
+    }
+
+    PGresult* dbResult = m_result;
+    m_result = nullptr;
+
+    auto result = std::make_shared<QueryResult>(dbResult, m_connection, m_executor->m_resultMapper, m_typeResolver);
+    if(m_connectionAcquired && m_executor->m_earlyConnectionRelease) {
+      result->releaseConnection();
+    }
+    return _return(result);
+
+  }
+
+};
+
+async::CoroutineStarterForResult<const provider::ResourceHandle<orm::Connection>&> Executor::getConnectionAsync() {
+
+  class GetConnectionCoroutine : public async::CoroutineWithResult<GetConnectionCoroutine, const provider::ResourceHandle<orm::Connection>&> {
+  private:
+    std::shared_ptr<provider::Provider<Connection>> m_connectionProvider;
+    std::shared_ptr<ConnectionInvalidator> m_connectionInvalidator;
+  public:
+
+    GetConnectionCoroutine(const std::shared_ptr<provider::Provider<Connection>>& connectionProvider,
+                           const std::shared_ptr<ConnectionInvalidator>& connectionInvalidator)
+      : m_connectionProvider(connectionProvider)
+      , m_connectionInvalidator(connectionInvalidator)
+    {}
+
+    Action act() override {
+      return m_connectionProvider->getAsync().callbackTo(&GetConnectionCoroutine::onConnection);
+    }
+
+    Action onConnection(const provider::ResourceHandle<Connection>& connection) {
+      if(connection) {
+        /* set correct invalidator before cast */
+        connection.object->setInvalidator(connection.invalidator);
+        return _return(provider::ResourceHandle<orm::Connection>(connection.object, m_connectionInvalidator));
+      }
+      return error<async::Error>("[oatpp::postgresql::Executor::getConnectionAsync()]: Error. Can't connect.");
+    }
+
+  };
+
+  return GetConnectionCoroutine::startForResult(m_connectionProvider, m_connectionInvalidator);
+
+}
+
+async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+Executor::executeAsync(const StringTemplate& queryTemplate,
+                       const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                       const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                       const provider::ResourceHandle<orm::Connection>& connection)
+{
+
+  std::shared_ptr<const data::mapping::TypeResolver> tr = typeResolver;
+  if(!tr) {
+    tr = m_defaultTypeResolver;
+  }
+
+  return QueryCoroutine::startForResult(this, std::make_shared<StringTemplate>(getExecutionTemplate(queryTemplate)),
+                                        nullptr, params, tr, connection);
+
+}
+
+async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+Executor::execAsync(const oatpp::String& statement, const provider::ResourceHandle<orm::Connection>& connection) {
+  return QueryCoroutine::startForResult(this, nullptr, statement, std::unordered_map<oatpp::String, oatpp::Void>(),
+                                        m_defaultTypeResolver, connection);
+}
+
+async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+Executor::beginAsync(const provider::ResourceHandle<orm::Connection>& connection) {
+  return execAsync("BEGIN", connection);
+}
+
+async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+Executor::commitAsync(const provider::ResourceHandle<orm::Connection>& connection) {
   if(!connection) {
-    throw std::runtime_error("[oatpp::postgresql::Executor::commit()]: "
+    throw std::runtime_error("[oatpp::postgresql::Executor::commitAsync()]: "
+                             "Error. Can't COMMIT - NULL connection.");
+  }
+  return execAsync("COMMIT", connection);
+}
+
+async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+Executor::rollbackAsync(const provider::ResourceHandle<orm::Connection>& connection) {
+  if(!connection) {
+    throw std::runtime_error("[oatpp::postgresql::Executor::rollbackAsync()]: "
                              "Error. Can't ROLLBACK - NULL connection.");
   }
-  return exec("ROLLBACK", connection);
+  return execAsync("ROLLBACK", connection);
 }
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Schema
+
 oatpp::String Executor::getSchemaVersionTableName(const oatpp::String& suffix) {
   data::stream::BufferOutputStream stream;
   stream << "oatpp_schema_version";
@@ -425,12 +2410,17 @@ v_int64 Executor::getSchemaVersion(const oatpp::String& suffix,
                                    const provider::ResourceHandle<orm::Connection>& connection)
 {
 
+  auto conn = connection;
+  if(!conn) {
+    conn = getConnection();
+  }
+
   std::shared_ptr<orm::QueryResult> result;
 
   {
     data::stream::BufferOutputStream stream;
     stream << "CREATE TABLE IF NOT EXISTS " << getSchemaVersionTableName(suffix) << " (version BIGINT)";
-    result = exec(stream.toString(), connection);
+    result = exec(stream.toString(), conn);
     if(!result->isSuccess()) {
       throw std::runtime_error("[oatpp::postgresql::Executor::getSchemaVersion()]: "
                                "Error. Can't create schema version table. " + *result->getErrorMessage());
@@ -439,7 +2429,7 @@ v_int64 Executor::getSchemaVersion(const oatpp::String& suffix,
 
   data::stream::BufferOutputStream stream;
   stream << "SELECT * FROM " << getSchemaVersionTableName(suffix);
-  result = exec(stream.toString(), result->getConnection(), true);
+  result = exec(stream.toString(), conn, true);
   if(!result->isSuccess()) {
     throw std::runtime_error("[oatpp::postgresql::Executor::getSchemaVersion()]: "
                              "Error. Can't get schema version. " + *result->getErrorMessage());
@@ -451,7 +2441,7 @@ v_int64 Executor::getSchemaVersion(const oatpp::String& suffix,
 
     stream.setCurrentPosition(0);
     stream << "INSERT INTO " << getSchemaVersionTableName(suffix) << " (version) VALUES (0)";
-    result = exec(stream.toString(), result->getConnection(), true);
+    result = exec(stream.toString(), conn, true);
 
     if(result->isSuccess()) {
       return 0;
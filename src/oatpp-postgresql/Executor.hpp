@@ -30,19 +30,106 @@
 
 #include "mapping/Serializer.hpp"
 #include "mapping/ResultMapper.hpp"
+#include "ql_template/Parser.hpp"
 #include "Types.hpp"
 
 #include "oatpp/orm/Executor.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
 
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <vector>
 
+namespace oatpp { namespace test { namespace postgresql { namespace mapping {
+  class SerializerAllocationTest;
+}}}}
+
 namespace oatpp { namespace postgresql {
 
 /**
  * Implementation of &id:oatpp::orm::Executor;. for PostgreSQL.
  */
 class Executor : public orm::Executor {
+  friend class oatpp::test::postgresql::mapping::SerializerAllocationTest; // measures allocations of QueryParams
+public:
+
+  /**
+   * Query to execute in a pipeline. See &l:Executor::executePipeline ();.
+   */
+  struct PipelineQuery {
+
+    /**
+     * Query template.
+     */
+    StringTemplate queryTemplate;
+
+    /**
+     * Query parameters.
+     */
+    std::unordered_map<oatpp::String, oatpp::Void> params;
+
+  };
+
+  /**
+   * Source of rows for &l:Executor::copyIn ();. <br>
+   * Returns the next row object or `nullptr` when there are no more rows.
+   */
+  typedef std::function<oatpp::Void()> CopyInRowProducer;
+
+  /**
+   * Receiver of rows for &l:Executor::copyOut ();. Called once per decoded row.
+   */
+  typedef std::function<void(const oatpp::Void&)> CopyOutRowConsumer;
+
+  /**
+   * Connection warm-up which prepares all prepared templates parsed by the executor. <br>
+   * Statements are prepared in a single pipeline (one network round trip) before the connection is handed out.
+   * See &id:oatpp::postgresql::ConnectionProvider::setWarmUp;.
+   */
+  class PreparedTemplatesWarmUp : public ConnectionProvider::WarmUp {
+  private:
+
+    struct Statement {
+      v_int64 id;
+      oatpp::String name;
+      oatpp::String text;
+      std::vector<Oid> paramTypes;
+    };
+
+  private:
+    std::vector<Statement> m_statements;
+    std::mutex m_mutex;
+  private:
+    std::vector<Statement> getStatements();
+  public:
+
+    /**
+     * Add statement to prepare on new connections. Statements with already registered ids are ignored.
+     * @param id - statement id. See &id:oatpp::postgresql::ql_template::Parser::TemplateExtra::templateId;.
+     * @param name - statement name.
+     * @param text - statement text.
+     * @param paramTypes - parameter types.
+     */
+    void addStatement(v_int64 id, const oatpp::String& name, const oatpp::String& text, std::vector<Oid>&& paramTypes);
+
+    /**
+     * Prepare all registered statements on the connection.
+     * Throws `std::runtime_error` if the connection is broken or can't leave pipeline mode - it must not be used then.
+     * @param connection
+     */
+    void warmUp(const std::shared_ptr<Connection>& connection) override;
+
+    /**
+     * Prepare all registered statements on the connection in Async manner.
+     * Coroutine finishes with an error if the connection is broken or can't leave pipeline mode.
+     * @param connection
+     * @return - &id:oatpp::async::CoroutineStarter;.
+     */
+    async::CoroutineStarter warmUpAsync(const std::shared_ptr<Connection>& connection) override;
+
+  };
+
 private:
 
   /*
@@ -64,9 +151,28 @@ private:
 
 private:
 
+  /*
+   * Serialized query parameters. <br>
+   * Storage for up to `INLINE_PARAMS_COUNT` parameters lives in the object itself - binding of a typical query
+   * with scalar parameters doesn't touch the heap. Larger parameter lists use one heap arena. <br>
+   * Arrays point into the object - it can be neither copied nor moved.
+   */
   class QueryParams {
   private:
-    std::vector<mapping::Serializer::OutputData> outData;
+    static constexpr v_int32 INLINE_PARAMS_COUNT = 8;
+  private:
+    mapping::Serializer::OutputData m_inlineOutData[INLINE_PARAMS_COUNT];
+    Oid m_inlineOids[INLINE_PARAMS_COUNT];
+    const char* m_inlineValues[INLINE_PARAMS_COUNT];
+    int m_inlineLengths[INLINE_PARAMS_COUNT];
+    int m_inlineFormats[INLINE_PARAMS_COUNT];
+    std::unique_ptr<mapping::Serializer::OutputData[]> m_heapOutData;
+    std::unique_ptr<char[]> m_heapArena;
+    mapping::Serializer::OutputData* m_outData;
+  private:
+    void allocate();
+    void init(const ql_template::Parser::TemplateExtra& extra, v_int32 paramsCount);
+    void bind(v_int32 index);
   public:
 
     QueryParams(const StringTemplate& queryTemplate,
@@ -74,15 +180,26 @@ private:
                 const mapping::Serializer& serializer,
                 const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver);
 
+    /*
+     * Positional parameters - one value per binding of the plan (distinct template variable), in the order of bindings.
+     * Values are bound as is - property paths of the variables are not resolved.
+     */
+    QueryParams(const StringTemplate& queryTemplate,
+                const std::vector<oatpp::Void>& params,
+                const mapping::Serializer& serializer);
+
+    QueryParams(const QueryParams&) = delete;
+    QueryParams& operator=(const QueryParams&) = delete;
+
     int count;
 
     const char* query;
     const char* queryName;
 
-    std::vector<Oid> paramOids;
-    std::vector<const char*> paramValues;
-    std::vector<int> paramLengths;
-    std::vector<int> paramFormats;
+    Oid* paramOids;
+    const char** paramValues;
+    int* paramLengths;
+    int* paramFormats;
 
   };
 
@@ -100,6 +217,16 @@ private:
 
 private:
 
+  static v_int64 getTemplateId(const oatpp::String& templateName);
+  static v_int64 getStatementId(const oatpp::String& statementKey);
+
+  const StringTemplate& getExecutionTemplate(const StringTemplate& queryTemplate);
+  std::shared_ptr<StringTemplate> promoteTemplate(const StringTemplate& queryTemplate);
+
+  std::vector<ql_template::Parser::ParameterBinding> getBindingPlan(const StringTemplate& queryTemplate,
+                                                                   const ParamsTypeMap& paramsTypeMap,
+                                                                   std::vector<v_uint32>& variableSlots);
+
   std::unique_ptr<Oid[]> getParamTypes(const StringTemplate& queryTemplate,
                                        const ParamsTypeMap& paramsTypeMap,
                                        const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver);
@@ -108,20 +235,69 @@ private:
                                             const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                             const provider::ResourceHandle<orm::Connection>& connection);
 
-  std::shared_ptr<QueryResult> executeQueryPrepared(const StringTemplate& queryTemplate,
-                                                    const std::unordered_map<oatpp::String, oatpp::Void>& params,
+  std::shared_ptr<QueryResult> executeQueryPrepared(const QueryParams& queryParams,
                                                     const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                                     const provider::ResourceHandle<orm::Connection>& connection);
 
-  std::shared_ptr<QueryResult> executeQuery(const StringTemplate& queryTemplate,
-                                            const std::unordered_map<oatpp::String, oatpp::Void>& params,
+  std::shared_ptr<QueryResult> executePipelined(const StringTemplate& queryTemplate,
+                                                const QueryParams& queryParams,
+                                                const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                const provider::ResourceHandle<orm::Connection>& connection,
+                                                bool prepareStatement,
+                                                const std::vector<oatpp::String>& deallocate);
+
+  std::shared_ptr<QueryResult> executeQuery(const QueryParams& queryParams,
                                             const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                             const provider::ResourceHandle<orm::Connection>& connection);
 
+  std::shared_ptr<QueryResult> executeWithParams(const StringTemplate& executionTemplate,
+                                                 const QueryParams& queryParams,
+                                                 const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                                                 const provider::ResourceHandle<orm::Connection>& connection,
+                                                 bool ownConnection);
+
+private:
+
+  static int sendPrepare(const StringTemplate& queryTemplate, const Oid* paramTypes, PGconn* handle);
+  static int sendQuery(const QueryParams& queryParams, bool prepared, PGconn* handle);
+  static int sendPipelineSync(PGconn* handle);
+  static PGresult* getPipelineResult(PGconn* handle);
+  static void skipPipelineSync(PGconn* handle);
+
+  /*
+   * Leave pipeline mode. Commands queued without a sync point are synced and all pending results are discarded.
+   * Returns `false` if the connection can't leave pipeline mode - it's unusable then.
+   */
+  static bool exitPipeline(PGconn* handle);
+
+  static oatpp::String getDeallocateStatement(const std::vector<oatpp::String>& statementNames, PGconn* handle);
+  static int sendDeallocate(const std::vector<oatpp::String>& statementNames, PGconn* handle);
+  static void readDeallocate(const std::vector<oatpp::String>& statementNames, Connection& connection);
+  static void deallocateStatements(const std::vector<oatpp::String>& statementNames, Connection& connection);
+  static bool isDeallocated(PGresult* result);
+
+  static void writeCopyField(data::stream::BufferOutputStream& stream, const mapping::Serializer::OutputData& data);
+  static bool flushCopyData(data::stream::BufferOutputStream& stream, PGconn* handle);
+  static v_buff_size readCopyHeader(const char* data, v_buff_size size);
+  static void cancelCopyOut(PGconn* handle);
+
+private:
+
+  /*
+   * Non-blocking query execution. Sends query with `PQsend*` and waits for the socket readiness in the IO event worker.
+   */
+  class QueryCoroutine;
+
+  async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+  execAsync(const oatpp::String& statement, const provider::ResourceHandle<orm::Connection>& connection);
+
 private:
   std::shared_ptr<ConnectionInvalidator> m_connectionInvalidator;
   std::shared_ptr<provider::Provider<Connection>> m_connectionProvider;
   std::shared_ptr<mapping::ResultMapper> m_resultMapper;
+  std::shared_ptr<PreparedTemplatesWarmUp> m_preparedTemplatesWarmUp;
+  std::atomic<v_int64> m_autoPrepareThreshold;
+  std::atomic<bool> m_earlyConnectionRelease;
   mapping::Serializer m_serializer;
 public:
 
@@ -129,6 +305,32 @@ public:
 
   std::shared_ptr<data::mapping::TypeResolver> createTypeResolver() override;
 
+  /**
+   * Get warm-up which prepares all prepared templates parsed by this executor on new connections. <br>
+   * Usage: `connectionProvider->setWarmUp(executor->getPreparedTemplatesWarmUp());`.
+   * @return - &l:Executor::PreparedTemplatesWarmUp;.
+   */
+  std::shared_ptr<PreparedTemplatesWarmUp> getPreparedTemplatesWarmUp();
+
+  /**
+   * Enable automatic promotion of unprepared templates to prepared statements. <br>
+   * Named template declared without `PREPARE(true)` is prepared on connection once it's executed `threshold` times.
+   * Rarely executed templates keep using unprepared path. <br>
+   * Only templates with known parameter types can be promoted.
+   * @param threshold - number of executions after which template is prepared. `0` - disabled (default).
+   */
+  void setAutoPrepareThreshold(v_int64 threshold);
+
+  /**
+   * Release connection acquired by the executor as soon as the query result is received. <br>
+   * The result is fully buffered in the client memory - the connection goes back to the pool
+   * while the application is still fetching rows. <br>
+   * Connections passed by the caller and connections in a transaction are never released early. <br>
+   * Enabled by default.
+   * @param enabled
+   */
+  void setEarlyConnectionRelease(bool enabled);
+
   StringTemplate parseQueryTemplate(const oatpp::String& name,
                                     const oatpp::String& text,
                                     const ParamsTypeMap& paramsTypeMap,
@@ -141,12 +343,244 @@ public:
                                             const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
                                             const provider::ResourceHandle<orm::Connection>& connection) override;
 
+  /**
+   * Execute query with positional parameters. <br>
+   * Parameters are given as an ordered array - one value per distinct template variable, in the order the variables
+   * first appear in the template text. A variable used several times in the template takes one value.
+   * No params map is built or looked up - values go straight to the precompiled binding plan.
+   * Values are bound as is: for variable `:user.name` pass the name itself, not the `user` object. <br>
+   * Example: for `SELECT * FROM users WHERE id=:id AND role=:role` pass `{oatpp::Int32(1), oatpp::String("admin")}`.
+   * @param queryTemplate - query template.
+   * @param params - parameter values in the order of template variables.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> executePositional(const StringTemplate& queryTemplate,
+                                                      const std::vector<oatpp::Void>& params,
+                                                      const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                                      const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
   std::shared_ptr<orm::QueryResult> begin(const provider::ResourceHandle<orm::Connection>& connection = nullptr) override;
 
   std::shared_ptr<orm::QueryResult> commit(const provider::ResourceHandle<orm::Connection>& connection) override;
 
   std::shared_ptr<orm::QueryResult> rollback(const provider::ResourceHandle<orm::Connection>& connection) override;
 
+  /**
+   * Execute queries in a single pipeline (libpq pipeline mode). <br>
+   * All queries are sent to the server without waiting for the results of the previous ones,
+   * so the whole batch costs one network round trip. <br>
+   * Each query is followed by its own sync point - an error in one query doesn't abort the other queries of the batch.
+   * Note that inside an explicit transaction an error still aborts the transaction. <br>
+   * *Note: the connection is used in the blocking mode - keep batches reasonably small.*
+   * @param queries - queries to execute.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - one &id:oatpp::orm::QueryResult; per query, in the same order as queries.
+   */
+  std::vector<std::shared_ptr<orm::QueryResult>> executePipeline(const std::vector<PipelineQuery>& queries,
+                                                                 const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                                                 const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Execute query once for a batch of parameter sets. <br>
+   * Parameters are transposed into columns - each template parameter is bound to a PostgreSQL array
+   * of its values across all parameter sets, in the batch order. The query is supposed to expand the arrays with `unnest`:
+   * `INSERT INTO users (id, name) SELECT * FROM unnest(:id, :name)`. <br>
+   * The whole batch is a single execution (one network round trip), and the template stays preparable regardless of the batch size -
+   * declare the parameter types as arrays: `{"id", oatpp::Vector<oatpp::Int32>::Class::getType()}`. <br>
+   * *Note: parameters must be referenced by plain names (no property paths) and their values must not be collections.*
+   * @param queryTemplate - query template.
+   * @param batch - parameter sets. Each set must contain all template parameters. Must not be empty.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> executeBatch(const StringTemplate& queryTemplate,
+                                                 const std::vector<std::unordered_map<oatpp::String, oatpp::Void>>& batch,
+                                                 const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                                 const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Execute query and stream its rows. <br>
+   * Rows are not buffered on the client - the query runs in libpq single-row mode,
+   * or in chunked-rows mode if `chunkSize > 1` and libpq supports it (`PQsetChunkedRowsMode`, libpq 17+). <br>
+   * &id:oatpp::orm::QueryResult::fetch; pulls the next chunks from the connection as rows are read,
+   * so memory usage doesn't depend on the size of the result set. <br>
+   * The connection is busy until all rows are read or the result is destroyed. If the result is destroyed early the query is canceled.
+   * @param queryTemplate - query template.
+   * @param params - query parameters.
+   * @param chunkSize - max number of rows in one chunk.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> executeStreaming(const StringTemplate& queryTemplate,
+                                                     const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                     v_int32 chunkSize = 1,
+                                                     const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                                     const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Execute SELECT query through the server-side cursor. <br>
+   * The query is wrapped in `DECLARE ... NO SCROLL CURSOR` in the current transaction of the connection.
+   * Each &id:oatpp::orm::QueryResult::fetch; with `count` maps to `FETCH count` - the server materializes only the rows
+   * which are consumed. The cursor is closed when the result is destroyed. <br>
+   * *Note: template is always executed as unprepared statement.*
+   * @param queryTemplate - query template. Must be a SELECT (or VALUES) query.
+   * @param params - query parameters.
+   * @param fetchSize - number of rows to fetch right after the cursor is declared.
+   * @param connection - connection with an open transaction. See &id:oatpp::orm::Transaction;.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> executeCursor(const StringTemplate& queryTemplate,
+                                                  const std::unordered_map<oatpp::String, oatpp::Void>& params,
+                                                  v_int64 fetchSize,
+                                                  const provider::ResourceHandle<orm::Connection>& connection,
+                                                  const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr);
+
+  /**
+   * Bulk insert rows with `COPY table (columns) FROM STDIN (FORMAT binary)`. <br>
+   * Columns are the properties of the `rowType` object, values are encoded with &id:oatpp::postgresql::mapping::Serializer;.
+   * Rows are pulled from the producer one by one and sent to the server in ~64KB portions with `PQputCopyData`,
+   * so the whole batch is never buffered on the client. <br>
+   * *Note: binary COPY doesn't convert types - DTO field types must match the column types exactly (ex.: `Int32` for `integer`).* <br>
+   * *Note: `tableName` is inserted into the statement as is. Never pass untrusted input here.* <br>
+   * If the producer throws, COPY is aborted, the connection is left in a usable state, and the exception is rethrown.
+   * @param tableName - name of the target table. May be schema-qualified.
+   * @param rowType - type of row objects. Must be an `oatpp::Object`.
+   * @param rowProducer - &l:Executor::CopyInRowProducer;.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> copyIn(const oatpp::String& tableName,
+                                           const oatpp::Type* rowType,
+                                           const CopyInRowProducer& rowProducer,
+                                           const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Bulk insert collection of DTOs with binary COPY. See &l:Executor::copyIn ();. <br>
+   * `nullptr` items of the collection are skipped.
+   * @tparam T - DTO type.
+   * @param tableName - name of the target table.
+   * @param rows - rows to insert.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  template<class T>
+  std::shared_ptr<orm::QueryResult> copyIn(const oatpp::String& tableName,
+                                           const oatpp::Vector<oatpp::Object<T>>& rows,
+                                           const provider::ResourceHandle<orm::Connection>& connection = nullptr)
+  {
+    v_buff_size index = 0;
+    v_buff_size size = rows ? static_cast<v_buff_size>(rows->size()) : 0;
+    return copyIn(tableName, oatpp::Object<T>::Class::getType(), [&rows, &index, size]() -> oatpp::Void {
+      while(index < size) {
+        const auto& row = rows[index ++];
+        if(row) {
+          return row;
+        }
+      }
+      return nullptr;
+    }, connection);
+  }
+
+  /**
+   * Bulk export query result with `COPY (query) TO STDOUT (FORMAT binary)`. <br>
+   * Tuples are read one by one with `PQgetCopyData`, decoded with &id:oatpp::postgresql::mapping::Deserializer;
+   * and passed to the consumer - client memory usage doesn't depend on the size of the result. <br>
+   * Rows are mapped the same way as by &id:oatpp::orm::QueryResult::fetch;. <br>
+   * Column types are taken from `SELECT * FROM (query) LIMIT 0` sent together with the COPY in one round trip -
+   * the query is planned twice, no prepared statement of the connection is touched. <br>
+   * *Note: COPY doesn't accept query parameters. Never build the query from untrusted input.* <br>
+   * If the consumer throws, the query is canceled, the connection is left in a usable state, and the exception is rethrown.
+   * @param query - SELECT (or VALUES) query.
+   * @param rowType - type of the row. See &id:oatpp::postgresql::mapping::ResultMapper::readOneRow;.
+   * @param rowConsumer - &l:Executor::CopyOutRowConsumer;.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  std::shared_ptr<orm::QueryResult> copyOut(const oatpp::String& query,
+                                            const oatpp::Type* rowType,
+                                            const CopyOutRowConsumer& rowConsumer,
+                                            const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                            const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Bulk export query result with binary COPY. See &l:Executor::copyOut ();. <br>
+   * Usage: `executor->copyOut<oatpp::Object<MyDto>>(query, [](const oatpp::Object<MyDto>& row) {...});`.
+   * @tparam T - row type.
+   * @param query - SELECT (or VALUES) query.
+   * @param rowConsumer - called once per row.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param connection - connection to use. If `nullptr` - new connection is acquired.
+   * @return - &id:oatpp::orm::QueryResult;.
+   */
+  template<class T>
+  std::shared_ptr<orm::QueryResult> copyOut(const oatpp::String& query,
+                                            const std::function<void(const T&)>& rowConsumer,
+                                            const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+                                            const provider::ResourceHandle<orm::Connection>& connection = nullptr)
+  {
+    return copyOut(query, T::Class::getType(), [&rowConsumer](const oatpp::Void& row) {
+      rowConsumer(row.template cast<T>());
+    }, typeResolver, connection);
+  }
+
+  /**
+   * Get connection in Async manner.
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of &id:oatpp::orm::Connection;.
+   */
+  async::CoroutineStarterForResult<const provider::ResourceHandle<orm::Connection>&> getConnectionAsync();
+
+  /**
+   * Execute query in Async manner. <br>
+   * Same as &l:Executor::execute (); but never blocks the async processor thread -
+   * the query is sent in non-blocking mode and the coroutine waits for the connection socket in the IO event worker. <br>
+   * The coroutine refers to this executor - the executor must outlive it.
+   * Keep the executor (or the &id:oatpp::orm::DbClient; holding it) alive until the coroutine is finished.
+   * @param queryTemplate - query template.
+   * @param params - query parameters.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param connection - connection to use. If `nullptr` - connection is acquired asynchronously.
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of &id:oatpp::orm::QueryResult;.
+   */
+  async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+  executeAsync(const StringTemplate& queryTemplate,
+               const std::unordered_map<oatpp::String, oatpp::Void>& params,
+               const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver = nullptr,
+               const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Begin transaction in Async manner.
+   * Same lifetime requirement as for &l:Executor::executeAsync ();.
+   * @param connection - connection to use. If `nullptr` - connection is acquired asynchronously.
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of &id:oatpp::orm::QueryResult;.
+   */
+  async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+  beginAsync(const provider::ResourceHandle<orm::Connection>& connection = nullptr);
+
+  /**
+   * Commit transaction in Async manner.
+   * Same lifetime requirement as for &l:Executor::executeAsync ();.
+   * @param connection
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of &id:oatpp::orm::QueryResult;.
+   */
+  async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+  commitAsync(const provider::ResourceHandle<orm::Connection>& connection);
+
+  /**
+   * Rollback transaction in Async manner.
+   * Same lifetime requirement as for &l:Executor::executeAsync ();.
+   * @param connection
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of &id:oatpp::orm::QueryResult;.
+   */
+  async::CoroutineStarterForResult<const std::shared_ptr<orm::QueryResult>&>
+  rollbackAsync(const provider::ResourceHandle<orm::Connection>& connection);
+
   v_int64 getSchemaVersion(const oatpp::String& suffix = nullptr,
                            const provider::ResourceHandle<orm::Connection>& connection = nullptr) override;
 
@@ -24,6 +24,8 @@
 
 #include "QueryResult.hpp"
 
+#include <limits>
+
 namespace oatpp { namespace postgresql {
 
 QueryResult::QueryResult(PGresult* dbResult,
@@ -34,12 +36,25 @@ QueryResult::QueryResult(PGresult* dbResult,
   , m_connection(connection)
   , m_resultMapper(resultMapper)
   , m_resultData(dbResult, typeResolver)
+  , m_streaming(false)
+  , m_streamFinished(false)
+  , m_chunkOffset(0)
+  , m_cursorFetchCount(0)
 {
   auto status = PQresultStatus(m_dbResult);
   switch(status) {
 
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+    case PGRES_TUPLES_CHUNK:
+#endif
     case PGRES_SINGLE_TUPLE: {
-      throw std::runtime_error("[oatpp::postgresql::QueryResult::QueryResult()]: Error. Single-row mode is not supported!");
+      m_success = true;
+      m_type = TYPE_TUPLES;
+      m_streaming = true;
+      m_resultData.fetchNextChunk = [this]() {
+        return fetchNextChunk();
+      };
+      break;
     }
 
     case PGRES_TUPLES_OK: {
@@ -55,18 +70,170 @@ QueryResult::QueryResult(PGresult* dbResult,
     }
 
     default: {
-      m_success = false;
-      m_type = TYPE_ERROR;
-      if(status == PGRES_FATAL_ERROR) {
-        connection.invalidator->invalidate(connection.object);
-      }
+      onError(m_dbResult);
     }
 
   }
 }
 
+QueryResult::QueryResult(PGresult* dbResult,
+                         const provider::ResourceHandle<orm::Connection>& connection,
+                         const std::shared_ptr<mapping::ResultMapper>& resultMapper,
+                         const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+                         const oatpp::String& cursorName,
+                         v_int64 fetchSize)
+  : QueryResult(dbResult, connection, resultMapper, typeResolver)
+{
+  if(m_success && m_type == TYPE_TUPLES) {
+    m_cursorName = cursorName;
+    m_cursorFetchCount = fetchSize;
+    m_streamFinished = fetchSize <= 0 || m_resultData.rowCount < fetchSize; // cursor is exhausted
+    m_resultData.fetchNextChunk = [this]() {
+      return fetchNextChunk();
+    };
+  }
+}
+
 QueryResult::~QueryResult() {
+
+  if(m_cursorName && m_connection) {
+    PGconn* handle = std::static_pointer_cast<postgresql::Connection>(m_connection.object)->getHandle();
+    if(PQtransactionStatus(handle) == PQTRANS_INTRANS) {
+      std::string statement = "CLOSE " + *m_cursorName;
+      PQclear(PQexec(handle, statement.c_str()));
+    }
+  }
+
+  if(m_streaming && !m_streamFinished) {
+    /* result is destroyed before all rows are read - cancel the query and drain the connection */
+    PGconn* handle = std::static_pointer_cast<postgresql::Connection>(m_connection.object)->getHandle();
+    PGcancel* cancel = PQgetCancel(handle);
+    if(cancel != nullptr) {
+      char errorBuffer[256];
+      PQcancel(cancel, errorBuffer, sizeof(errorBuffer));
+      PQfreeCancel(cancel);
+    }
+    PGresult* result;
+    while((result = PQgetResult(handle)) != nullptr) {
+      PQclear(result);
+    }
+  }
+
   PQclear(m_dbResult);
+
+}
+
+void QueryResult::onError(PGresult* dbResult) {
+  m_success = false;
+  m_type = TYPE_ERROR;
+  /* capture message now - the connection may be released before the message is read */
+  m_errorMessage = PQresultErrorMessage(dbResult);
+  if(m_errorMessage->empty()) {
+    auto pgConnection = std::static_pointer_cast<postgresql::Connection>(m_connection.object);
+    m_errorMessage = PQerrorMessage(pgConnection->getHandle());
+  }
+  if(PQresultStatus(dbResult) == PGRES_FATAL_ERROR) {
+    m_connection.invalidator->invalidate(m_connection.object);
+  }
+}
+
+void QueryResult::setChunk(PGresult* dbResult) {
+  m_chunkOffset += m_resultData.rowCount;
+  PQclear(m_dbResult);
+  m_dbResult = dbResult;
+  m_resultData.dbResult = dbResult;
+  m_resultData.rowIndex = 0;
+  m_resultData.rowCount = PQntuples(dbResult);
+}
+
+bool QueryResult::fetchCursorChunk() {
+
+  if(m_streamFinished) {
+    return false;
+  }
+
+  PGconn* handle = std::static_pointer_cast<postgresql::Connection>(m_connection.object)->getHandle();
+
+  std::string statement;
+  if(m_cursorFetchCount > 0) {
+    statement = "FETCH FORWARD " + std::to_string(m_cursorFetchCount) + " FROM " + *m_cursorName;
+  } else {
+    statement = "FETCH ALL FROM " + *m_cursorName;
+  }
+
+  PGresult* next = PQexecParams(handle, statement.c_str(), 0, nullptr, nullptr, nullptr, nullptr, 1);
+
+  if(PQresultStatus(next) != PGRES_TUPLES_OK) {
+    onError(next);
+    PQclear(next);
+    m_streamFinished = true;
+    return false;
+  }
+
+  setChunk(next);
+
+  if(m_cursorFetchCount <= 0 || m_resultData.rowCount < m_cursorFetchCount) {
+    m_streamFinished = true; // cursor is exhausted
+  }
+
+  return m_resultData.rowCount > 0;
+
+}
+
+bool QueryResult::fetchNextChunk() {
+
+  if(m_cursorName) {
+    return fetchCursorChunk();
+  }
+
+  PGconn* handle = std::static_pointer_cast<postgresql::Connection>(m_connection.object)->getHandle();
+
+  while(!m_streamFinished) {
+
+    PGresult* next = PQgetResult(handle);
+    if(next == nullptr) {
+      m_streamFinished = true;
+      break;
+    }
+
+    switch(PQresultStatus(next)) {
+
+#if defined(LIBPQ_HAS_CHUNK_MODE)
+      case PGRES_TUPLES_CHUNK:
+#endif
+      case PGRES_SINGLE_TUPLE: {
+        setChunk(next);
+        if(m_resultData.rowCount > 0) {
+          return true;
+        }
+        break;
+      }
+
+      case PGRES_TUPLES_OK: {
+        PQclear(next); // end of rows - NULL follows
+        break;
+      }
+
+      default: {
+        onError(next);
+        PQclear(next);
+      }
+
+    }
+
+  }
+
+  return false;
+
+}
+
+void QueryResult::releaseConnection() {
+  if(m_connection) {
+    auto pgConnection = std::static_pointer_cast<postgresql::Connection>(m_connection.object);
+    if(PQtransactionStatus(pgConnection->getHandle()) == PQTRANS_IDLE) {
+      m_connection = nullptr;
+    }
+  }
 }
 
 provider::ResourceHandle<orm::Connection> QueryResult::getConnection() const {
@@ -78,31 +245,103 @@ bool QueryResult::isSuccess() const {
 }
 
 oatpp::String QueryResult::getErrorMessage() const {
-  if(!m_success) {
-    auto pgConnection = std::static_pointer_cast<postgresql::Connection>(m_connection.object);
-    return PQerrorMessage(pgConnection->getHandle());
-  }
-  return nullptr;
+  return m_errorMessage;
 }
 
 v_int64 QueryResult::getPosition() const {
-  return m_resultData.rowIndex;
+  return m_chunkOffset + m_resultData.rowIndex;
 }
 
 v_int64 QueryResult::getKnownCount() const {
   switch(m_type) {
-    case TYPE_TUPLES: return m_resultData.rowCount;
+    case TYPE_TUPLES: return m_chunkOffset + m_resultData.rowCount;
 //    case TYPE_COMMAND: return 0;
   }
   return 0;
 }
 
+void QueryResult::readAhead() {
+  /*
+   * Current chunk is consumed - pull the next row of the stream now, while the rows are flowing anyway,
+   * so that hasMoreToFetch() knows the answer without network IO. Cursor doesn't read ahead - it would cost a round trip.
+   */
+  if(m_streaming && !m_streamFinished && m_resultData.rowIndex >= m_resultData.rowCount) {
+    fetchNextChunk();
+  }
+}
+
 bool QueryResult::hasMoreToFetch() const {
+  if(m_streaming || m_cursorName) {
+    return m_resultData.rowIndex < m_resultData.rowCount || !m_streamFinished;
+  }
   return getKnownCount() > 0;
 }
 
 oatpp::Void QueryResult::fetch(const oatpp::Type* const resultType, v_int64 count) {
-  return m_resultMapper->readRows(&m_resultData, resultType, count);
+  if(m_cursorName) {
+    m_cursorFetchCount = count; // FETCH as many rows as requested. -1 - FETCH ALL
+  }
+  auto result = m_resultMapper->readRows(&m_resultData, resultType, count);
+  readAhead();
+  return result;
+}
+
+std::vector<mapping::ColumnReader::Column> QueryResult::fetchColumns(const std::vector<oatpp::String>& columnNames, v_int64 count) {
+
+  if(m_type != TYPE_TUPLES) {
+    throw std::runtime_error("[oatpp::postgresql::QueryResult::fetchColumns()]: Error. The result has no rows.");
+  }
+
+  std::vector<v_int32> indices;
+  std::vector<mapping::ColumnReader::Column> columns;
+  indices.reserve(columnNames.size());
+  columns.reserve(columnNames.size());
+
+  for(const auto& name : columnNames) {
+    auto it = m_resultData.colIndices.find(name);
+    if(it == m_resultData.colIndices.end()) {
+      throw std::runtime_error("[oatpp::postgresql::QueryResult::fetchColumns()]: Error. No column '" + *name + "'.");
+    }
+    indices.push_back(it->second);
+    columns.push_back(mapping::ColumnReader::createColumn(m_resultData.dbResult, it->second));
+  }
+
+  if(m_cursorName) {
+    m_cursorFetchCount = count; // FETCH as many rows as requested. -1 - FETCH ALL
+  }
+
+  if(count == -1) {
+    count = m_resultData.fetchNextChunk ? std::numeric_limits<v_int64>::max() : m_resultData.rowCount;
+  }
+
+  mapping::ColumnReader::Scratch scratch;
+
+  while(count > 0) {
+
+    if(m_resultData.rowIndex >= m_resultData.rowCount) {
+      if(!m_resultData.fetchNextChunk || !m_resultData.fetchNextChunk()) {
+        break;
+      }
+    }
+
+    v_int64 chunkCount = m_resultData.rowCount - m_resultData.rowIndex;
+    if(chunkCount > count) {
+      chunkCount = count;
+    }
+
+    for(size_t i = 0; i < columns.size(); i ++) {
+      mapping::ColumnReader::readRows(columns[i], m_resultData.dbResult, indices[i], m_resultData.rowIndex, chunkCount, scratch);
+    }
+
+    m_resultData.rowIndex += chunkCount;
+    count -= chunkCount;
+
+  }
+
+  readAhead();
+
+  return columns;
+
 }
 
 }}
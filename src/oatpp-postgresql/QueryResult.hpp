@@ -26,6 +26,7 @@
 #define oatpp_postgresql_QueryResult_hpp
 
 #include "ConnectionProvider.hpp"
+#include "mapping/ColumnReader.hpp"
 #include "mapping/Deserializer.hpp"
 #include "mapping/ResultMapper.hpp"
 #include "oatpp/orm/QueryResult.hpp"
@@ -34,7 +35,11 @@ namespace oatpp { namespace postgresql {
 
 
 /**
- * Implementation of &id:oatpp::orm::QueryResult;. for PostgreSQL.
+ * Implementation of &id:oatpp::orm::QueryResult;. for PostgreSQL. <br>
+ * If constructed with the first result of a query in single-row or chunked-rows mode,
+ * rows are pulled from the connection chunk by chunk as they are fetched. See &id:oatpp::postgresql::Executor::executeStreaming;. <br>
+ * If constructed with a cursor name, each fetch maps to `FETCH` from the server-side cursor.
+ * See &id:oatpp::postgresql::Executor::executeCursor;.
  */
 class QueryResult : public orm::QueryResult {
 private:
@@ -44,10 +49,23 @@ private:
 private:
   PGresult* m_dbResult;
   provider::ResourceHandle<orm::Connection> m_connection;
+  oatpp::String m_errorMessage;
   std::shared_ptr<mapping::ResultMapper> m_resultMapper;
   mapping::ResultMapper::ResultData m_resultData;
   bool m_success;
   v_int32 m_type;
+private:
+  bool m_streaming;
+  bool m_streamFinished;
+  v_int64 m_chunkOffset;
+  oatpp::String m_cursorName;
+  v_int64 m_cursorFetchCount;
+private:
+  void setChunk(PGresult* dbResult);
+  bool fetchNextChunk();
+  bool fetchCursorChunk();
+  void readAhead();
+  void onError(PGresult* dbResult);
 private:
   mapping::Deserializer m_deserializer;
 public:
@@ -57,8 +75,31 @@ public:
               const std::shared_ptr<mapping::ResultMapper>& resultMapper,
               const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver);
 
+  /**
+   * Constructor for the result read from the server-side cursor.
+   * @param dbResult - result of the first `FETCH`.
+   * @param connection - connection. Must be in the transaction which declared the cursor.
+   * @param resultMapper - &id:oatpp::postgresql::mapping::ResultMapper;.
+   * @param typeResolver - &id:oatpp::data::mapping::TypeResolver;.
+   * @param cursorName - name of the declared cursor.
+   * @param fetchSize - number of rows requested by the first `FETCH`.
+   */
+  QueryResult(PGresult* dbResult,
+              const provider::ResourceHandle<orm::Connection>& connection,
+              const std::shared_ptr<mapping::ResultMapper>& resultMapper,
+              const std::shared_ptr<const data::mapping::TypeResolver>& typeResolver,
+              const oatpp::String& cursorName,
+              v_int64 fetchSize);
+
   ~QueryResult();
 
+  /**
+   * Release connection if it's not in a transaction. <br>
+   * The result is fully buffered in the client memory, so the connection can go back to the pool
+   * while rows are still being fetched. After the release &l:QueryResult::getConnection (); returns `nullptr`.
+   */
+  void releaseConnection();
+
   provider::ResourceHandle<orm::Connection> getConnection() const override;
 
   bool isSuccess() const override;
@@ -69,10 +110,29 @@ public:
 
   v_int64 getKnownCount() const override;
 
+  /**
+   * Check if there are more rows to fetch. Never does network IO. <br>
+   * A streamed result reads ahead to the next row once the current chunk is consumed, so the answer is exact.
+   * A cursor result knows it's exhausted only after a `FETCH` returned fewer rows than requested -
+   * if the remaining rows fit the last `FETCH` exactly, one more fetch returns no rows.
+   * @return
+   */
   bool hasMoreToFetch() const override;
 
   oatpp::Void fetch(const oatpp::Type* const resultType, v_int64 count) override;
 
+  /**
+   * Fetch rows as columns - values of each selected column are decoded into contiguous typed buffers
+   * with a separate null bitmap, without creating oatpp objects per value. <br>
+   * Supported column types are integers and `timestamp` (as `int64`), `float4`/`float8` (as `double`) and text types.
+   * Rows are consumed the same way as by &l:QueryResult::fetch ();. <br>
+   * Byte order conversion is vectorized only if the library is compiled with `-mssse3` or higher (e.g. `-march=native`).
+   * @param columnNames - names of the columns to decode.
+   * @param count - max number of rows to fetch. `-1` - all rows.
+   * @return - one &id:oatpp::postgresql::mapping::ColumnReader::Column; per name, in the same order.
+   */
+  std::vector<mapping::ColumnReader::Column> fetchColumns(const std::vector<oatpp::String>& columnNames, v_int64 count = -1);
+
 };
 
 }}
@@ -0,0 +1,411 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ShardedConnectionPool.hpp"
+
+#include <algorithm>
+#include <thread>
+
+namespace oatpp { namespace postgresql {
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ShardedConnectionPool::PooledConnection
+
+class ShardedConnectionPool::PooledConnection : public Connection {
+private:
+  std::shared_ptr<ShardedConnectionPool> m_pool;
+  provider::ResourceHandle<Connection> m_connection;
+  bool m_valid;
+public:
+
+  PooledConnection(const std::shared_ptr<ShardedConnectionPool>& pool,
+                   const provider::ResourceHandle<Connection>& connection)
+    : m_pool(pool)
+    , m_connection(connection)
+    , m_valid(true)
+  {}
+
+  ~PooledConnection() {
+    m_pool->release(m_connection, m_valid);
+  }
+
+  void invalidate() {
+    m_valid = false;
+  }
+
+  PGconn* getHandle() override {
+    return m_connection.object->getHandle();
+  }
+
+  void setPrepared(v_int64 statementId, const oatpp::String& statementName) override {
+    m_connection.object->setPrepared(statementId, statementName);
+  }
+
+  bool isPrepared(v_int64 statementId) const override {
+    return m_connection.object->isPrepared(statementId);
+  }
+
+  void recordExecution(v_int64 statementId, bool prepared) override {
+    m_connection.object->recordExecution(statementId, prepared);
+  }
+
+  std::vector<oatpp::String> getEvictedStatements() override {
+    return m_connection.object->getEvictedStatements();
+  }
+
+  void setDeallocated(const oatpp::String& statementName) override {
+    m_connection.object->setDeallocated(statementName);
+  }
+
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ShardedConnectionPool::ConnectionInvalidator
+
+void ShardedConnectionPool::ConnectionInvalidator::invalidate(const std::shared_ptr<Connection>& resource) {
+  auto connection = std::static_pointer_cast<PooledConnection>(resource);
+  connection->invalidate();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// ShardedConnectionPool
+
+ShardedConnectionPool::ShardedConnectionPool(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                                             v_int64 maxResources,
+                                             const std::chrono::microseconds& maxResourceTTL,
+                                             const std::chrono::microseconds& timeout,
+                                             v_uint32 shardsCount)
+  : m_provider(provider)
+  , m_invalidator(std::make_shared<ConnectionInvalidator>())
+  , m_maxResources(maxResources)
+  , m_maxResourceTTL(maxResourceTTL)
+  , m_timeout(timeout)
+  , m_shardsCount(shardsCount)
+  , m_size(0)
+  , m_running(true)
+  , m_waitersCount(0)
+{
+  if(m_shardsCount == 0) {
+    m_shardsCount = std::thread::hardware_concurrency();
+    if(m_shardsCount == 0) {
+      m_shardsCount = 1;
+    }
+  }
+  m_shards.reset(new Shard[m_shardsCount]);
+  m_waitList.setListener(this);
+}
+
+std::shared_ptr<ShardedConnectionPool> ShardedConnectionPool::createShared(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                                                                           v_int64 maxResources,
+                                                                           const std::chrono::microseconds& maxResourceTTL,
+                                                                           const std::chrono::microseconds& timeout,
+                                                                           v_uint32 shardsCount)
+{
+  return std::make_shared<ShardedConnectionPool>(provider, maxResources, maxResourceTTL, timeout, shardsCount);
+}
+
+v_uint32 ShardedConnectionPool::getShardIndex() {
+  static std::atomic<v_uint32> threadsCounter(0);
+  static thread_local v_uint32 threadIndex = threadsCounter ++;
+  return threadIndex % m_shardsCount;
+}
+
+bool ShardedConnectionPool::popIdle(Shard& shard, bool wait, provider::ResourceHandle<Connection>& result) {
+
+  while(true) {
+
+    IdleConnection idle;
+
+    {
+      std::unique_lock<std::mutex> lock(shard.mutex, std::defer_lock);
+      if(wait) {
+        lock.lock();
+      } else if(!lock.try_lock()) {
+        return false;
+      }
+      if(shard.connections.empty()) {
+        return false;
+      }
+      idle = std::move(shard.connections.back());
+      shard.connections.pop_back();
+    }
+
+    if(std::chrono::steady_clock::now() - idle.releaseTime < m_maxResourceTTL) {
+      result = idle.connection;
+      return true;
+    }
+
+    /* connection stayed idle for too long - close it outside of the shard lock. */
+    /* Threads are not notified here - the caller may hold the wait lock. They recheck the pool periodically. */
+    idle.connection.invalidator->invalidate(idle.connection.object);
+    m_size --;
+    m_waitList.notifyFirst();
+
+  }
+
+}
+
+bool ShardedConnectionPool::tryAcquire(provider::ResourceHandle<Connection>& result) {
+
+  v_uint32 index = getShardIndex();
+
+  if(popIdle(m_shards[index], true, result)) {
+    return true;
+  }
+
+  /* steal - first skip the busy shards, then wait for them */
+  for(v_uint32 pass = 0; pass < 2; pass ++) {
+    for(v_uint32 i = 1; i < m_shardsCount; i ++) {
+      if(popIdle(m_shards[(index + i) % m_shardsCount], pass > 0, result)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+
+}
+
+bool ShardedConnectionPool::reserve() {
+  v_int64 size = m_size.load();
+  while(size < m_maxResources) {
+    if(m_size.compare_exchange_weak(size, size + 1)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ShardedConnectionPool::unreserve() {
+  m_size --;
+  notifyWaiters();
+}
+
+void ShardedConnectionPool::notifyWaiters() {
+  if(m_waitersCount.load() > 0) {
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    m_waitCondition.notify_one();
+  }
+  m_waitList.notifyFirst();
+}
+
+bool ShardedConnectionPool::hasAvailable() {
+  if(m_size.load() < m_maxResources) {
+    return true;
+  }
+  for(v_uint32 i = 0; i < m_shardsCount; i ++) {
+    std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+    if(!m_shards[i].connections.empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ShardedConnectionPool::onNewItem(async::CoroutineWaitList& list) {
+  if(!m_running) {
+    list.notifyAll();
+  } else if(hasAvailable()) {
+    list.notifyFirst();
+  }
+}
+
+void ShardedConnectionPool::release(const provider::ResourceHandle<Connection>& connection, bool valid) {
+
+  bool pooled = false;
+
+  if(valid) {
+    auto& shard = m_shards[getShardIndex()];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    if(m_running) {
+      shard.connections.push_back({connection, std::chrono::steady_clock::now()});
+      pooled = true;
+    }
+  }
+
+  if(!pooled) {
+    connection.invalidator->invalidate(connection.object);
+    m_size --;
+  }
+
+  notifyWaiters();
+
+}
+
+provider::ResourceHandle<Connection> ShardedConnectionPool::wrap(const provider::ResourceHandle<Connection>& connection) {
+  return provider::ResourceHandle<Connection>(
+    std::make_shared<PooledConnection>(shared_from_this(), connection),
+    m_invalidator
+  );
+}
+
+provider::ResourceHandle<Connection> ShardedConnectionPool::get() {
+
+  auto deadline = std::chrono::steady_clock::now() + m_timeout;
+
+  while(true) {
+
+    if(!m_running) {
+      throw std::runtime_error("[oatpp::postgresql::ShardedConnectionPool::get()]: Error. Pool is stopped.");
+    }
+
+    provider::ResourceHandle<Connection> connection;
+
+    if(tryAcquire(connection)) {
+      return wrap(connection);
+    }
+
+    if(reserve()) {
+      try {
+        connection = m_provider->get();
+      } catch (...) {
+        unreserve();
+        throw;
+      }
+      if(!connection) {
+        unreserve();
+        return nullptr;
+      }
+      return wrap(connection);
+    }
+
+    /* pool is exhausted - wait for a connection to be released */
+    {
+      std::unique_lock<std::mutex> lock(m_waitMutex);
+      m_waitersCount ++;
+      bool acquired = tryAcquire(connection);
+      if(!acquired && m_size.load() >= m_maxResources) {
+        m_waitCondition.wait_until(lock, std::min(deadline, std::chrono::steady_clock::now() + std::chrono::milliseconds(100)));
+      }
+      m_waitersCount --;
+      if(acquired) {
+        return wrap(connection);
+      }
+    }
+
+    if(std::chrono::steady_clock::now() >= deadline) {
+      return nullptr;
+    }
+
+  }
+
+}
+
+async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&> ShardedConnectionPool::getAsync() {
+
+  class GetCoroutine : public async::CoroutineWithResult<GetCoroutine, const provider::ResourceHandle<Connection>&> {
+  private:
+    std::shared_ptr<ShardedConnectionPool> m_pool;
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_reserved;
+  public:
+
+    GetCoroutine(const std::shared_ptr<ShardedConnectionPool>& pool)
+      : m_pool(pool)
+      , m_deadline(std::chrono::steady_clock::now() + pool->m_timeout)
+      , m_reserved(false)
+    {}
+
+    ~GetCoroutine() override {
+      if(m_reserved) {
+        m_pool->unreserve(); // provider failed to connect
+      }
+    }
+
+    Action act() override {
+
+      if(!m_pool->m_running) {
+        return error<async::Error>("[oatpp::postgresql::ShardedConnectionPool::getAsync()]: Error. Pool is stopped.");
+      }
+
+      provider::ResourceHandle<Connection> connection;
+
+      if(m_pool->tryAcquire(connection)) {
+        return _return(m_pool->wrap(connection));
+      }
+
+      if(m_pool->reserve()) {
+        m_reserved = true;
+        return m_pool->m_provider->getAsync().callbackTo(&GetCoroutine::onConnection);
+      }
+
+      if(std::chrono::steady_clock::now() >= m_deadline) {
+        return _return(provider::ResourceHandle<Connection>());
+      }
+
+      /* woken up when a connection is released or a reservation is freed */
+      return Action::createWaitListActionWithTimeout(&m_pool->m_waitList, m_deadline);
+
+    }
+
+    Action onConnection(const provider::ResourceHandle<Connection>& connection) {
+      m_reserved = false;
+      if(!connection) {
+        m_pool->unreserve();
+        return _return(connection);
+      }
+      return _return(m_pool->wrap(connection));
+    }
+
+  };
+
+  return GetCoroutine::startForResult(shared_from_this());
+
+}
+
+void ShardedConnectionPool::stop() {
+
+  m_running = false;
+
+  for(v_uint32 i = 0; i < m_shardsCount; i ++) {
+
+    std::vector<IdleConnection> connections;
+    {
+      std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+      connections.swap(m_shards[i].connections);
+    }
+
+    for(auto& idle : connections) {
+      idle.connection.invalidator->invalidate(idle.connection.object);
+      m_size --;
+    }
+
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_waitMutex);
+    m_waitCondition.notify_all();
+  }
+  m_waitList.notifyAll();
+
+  m_provider->stop();
+
+}
+
+v_int64 ShardedConnectionPool::getSize() {
+  return m_size.load();
+}
+
+}}
@@ -0,0 +1,167 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_postgresql_ShardedConnectionPool_hpp
+#define oatpp_postgresql_ShardedConnectionPool_hpp
+
+#include "Connection.hpp"
+
+#include "oatpp/provider/Provider.hpp"
+#include "oatpp/async/CoroutineWaitList.hpp"
+#include "oatpp/Types.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+namespace oatpp { namespace postgresql {
+
+/**
+ * Connection pool sharded by threads. <br>
+ * Idle connections are kept in several shards, each guarded by its own mutex.
+ * Every thread is bound to one shard, so that acquire and release of a connection normally lock that shard only.
+ * When the shard of the thread is empty, an idle connection is stolen from other shards. <br>
+ * Global lock is taken only when the pool is exhausted and the caller has to wait for a connection.
+ * Async callers wait on the coroutine wait list instead. <br>
+ * Drop-in replacement for &id:oatpp::postgresql::ConnectionPool;.
+ */
+class ShardedConnectionPool : public provider::Provider<Connection>,
+                              public async::CoroutineWaitList::Listener,
+                              public std::enable_shared_from_this<ShardedConnectionPool> {
+private:
+
+  struct IdleConnection {
+    provider::ResourceHandle<Connection> connection;
+    std::chrono::steady_clock::time_point releaseTime;
+  };
+
+  struct Shard {
+    std::mutex mutex;
+    std::vector<IdleConnection> connections;
+    v_char8 padding[64]; // keep shards in different cache lines
+  };
+
+  class PooledConnection;
+
+  class ConnectionInvalidator : public provider::Invalidator<Connection> {
+  public:
+    void invalidate(const std::shared_ptr<Connection>& resource) override;
+  };
+
+private:
+  v_uint32 getShardIndex();
+  bool popIdle(Shard& shard, bool wait, provider::ResourceHandle<Connection>& result);
+  bool tryAcquire(provider::ResourceHandle<Connection>& result);
+  bool reserve();
+  void unreserve();
+  void notifyWaiters();
+  bool hasAvailable();
+  void release(const provider::ResourceHandle<Connection>& connection, bool valid);
+  provider::ResourceHandle<Connection> wrap(const provider::ResourceHandle<Connection>& connection);
+private:
+  std::shared_ptr<provider::Provider<Connection>> m_provider;
+  std::shared_ptr<ConnectionInvalidator> m_invalidator;
+  v_int64 m_maxResources;
+  std::chrono::microseconds m_maxResourceTTL;
+  std::chrono::microseconds m_timeout;
+  v_uint32 m_shardsCount;
+  std::unique_ptr<Shard[]> m_shards;
+  std::atomic<v_int64> m_size;
+  std::atomic<bool> m_running;
+private:
+  std::mutex m_waitMutex;
+  std::condition_variable m_waitCondition;
+  std::atomic<v_int32> m_waitersCount;
+  async::CoroutineWaitList m_waitList;
+public:
+
+  /**
+   * Constructor. Use &l:ShardedConnectionPool::createShared (); - pool must be owned by `std::shared_ptr`.
+   * @param provider - provider of underlying connections. Ex.: &id:oatpp::postgresql::ConnectionProvider;.
+   * @param maxResources - max number of connections.
+   * @param maxResourceTTL - max time for connection to stay idle in the pool.
+   * @param timeout - max time to wait for a free connection when the pool is exhausted.
+   * @param shardsCount - number of shards. `0` - number of hardware threads.
+   */
+  ShardedConnectionPool(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                        v_int64 maxResources,
+                        const std::chrono::microseconds& maxResourceTTL,
+                        const std::chrono::microseconds& timeout,
+                        v_uint32 shardsCount);
+
+  /**
+   * Create shared ShardedConnectionPool.
+   * @param provider - provider of underlying connections. Ex.: &id:oatpp::postgresql::ConnectionProvider;.
+   * @param maxResources - max number of connections.
+   * @param maxResourceTTL - max time for connection to stay idle in the pool.
+   * @param timeout - max time to wait for a free connection when the pool is exhausted.
+   * @param shardsCount - number of shards. `0` - number of hardware threads.
+   * @return - `std::shared_ptr` to ShardedConnectionPool.
+   */
+  static std::shared_ptr<ShardedConnectionPool> createShared(const std::shared_ptr<provider::Provider<Connection>>& provider,
+                                                             v_int64 maxResources,
+                                                             const std::chrono::microseconds& maxResourceTTL,
+                                                             const std::chrono::microseconds& timeout = std::chrono::seconds(10),
+                                                             v_uint32 shardsCount = 0);
+
+  /**
+   * Get Connection. <br>
+   * Waits for a free connection if the pool is exhausted.
+   * @return - resource. `nullptr` if timeout elapsed.
+   */
+  provider::ResourceHandle<Connection> get() override;
+
+  /**
+   * Get Connection in Async manner. <br>
+   * If the pool is exhausted the coroutine waits on the wait list until a connection is released or timeout elapses.
+   * @return - &id:oatpp::async::CoroutineStarterForResult; of `Connection`. `nullptr` if timeout elapsed.
+   */
+  async::CoroutineStarterForResult<const provider::ResourceHandle<Connection>&> getAsync() override;
+
+  /**
+   * Called when a coroutine starts waiting on the wait list. Wakes it right away if a connection became available
+   * between its last check and the wait.
+   * @param list - wait list.
+   */
+  void onNewItem(async::CoroutineWaitList& list) override;
+
+  /**
+   * Stop pool. Close idle connections and stop the underlying provider.
+   */
+  void stop() override;
+
+  /**
+   * Get number of connections currently owned by the pool - both idle and acquired.
+   * @return
+   */
+  v_int64 getSize();
+
+};
+
+}}
+
+#endif // oatpp_postgresql_ShardedConnectionPool_hpp
@@ -0,0 +1,171 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_postgresql_WindowedBatcher_hpp
+#define oatpp_postgresql_WindowedBatcher_hpp
+
+#include "oatpp/Types.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace oatpp { namespace postgresql {
+
+/**
+ * Collects items submitted by many threads and hands them to the flush function in batches on its own thread. <br>
+ * A batch is cut once `maxBatchSize` items are collected or `window` elapsed since the first item of the batch. <br>
+ * Used by &id:oatpp::postgresql::WriteCoalescer; and &id:oatpp::postgresql::BatchLoader;.
+ * @tparam Item - batch item type. Must be movable.
+ */
+template<class Item>
+class WindowedBatcher {
+public:
+
+  /**
+   * Flush function. Called on the batcher thread without the lock held.
+   */
+  typedef std::function<void(std::vector<Item>& batch)> FlushFunction;
+
+private:
+  v_int64 m_maxBatchSize;
+  std::chrono::microseconds m_window;
+  FlushFunction m_flush;
+private:
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::vector<Item> m_pending;
+  std::chrono::steady_clock::time_point m_pendingSince;
+  bool m_running;
+  std::thread m_thread;
+private:
+
+  void run() {
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while(true) {
+
+      m_condition.wait(lock, [this] { return !m_pending.empty() || !m_running; });
+
+      if(m_pending.empty()) {
+        break; // stopped
+      }
+
+      m_condition.wait_until(lock, m_pendingSince + m_window, [this] {
+        return static_cast<v_int64>(m_pending.size()) >= m_maxBatchSize || !m_running;
+      });
+
+      std::vector<Item> batch;
+      if(static_cast<v_int64>(m_pending.size()) > m_maxBatchSize) {
+        batch.reserve(m_maxBatchSize);
+        std::move(m_pending.begin(), m_pending.begin() + m_maxBatchSize, std::back_inserter(batch));
+        m_pending.erase(m_pending.begin(), m_pending.begin() + m_maxBatchSize);
+        m_pendingSince = std::chrono::steady_clock::now();
+      } else {
+        std::swap(batch, m_pending);
+      }
+
+      lock.unlock();
+      m_flush(batch);
+      lock.lock();
+
+    }
+
+  }
+
+public:
+
+  /**
+   * Constructor. The batcher thread is started by &l:WindowedBatcher::start ();.
+   * @param maxBatchSize - max number of items in one batch. Must be > 0.
+   * @param window - max time the first item of the batch waits for other items.
+   * @param flush - &l:WindowedBatcher::FlushFunction;.
+   */
+  WindowedBatcher(v_int64 maxBatchSize, const std::chrono::microseconds& window, const FlushFunction& flush)
+    : m_maxBatchSize(maxBatchSize)
+    , m_window(window)
+    , m_flush(flush)
+    , m_running(true)
+  {}
+
+  /**
+   * Non-virtual destructor. Calls &l:WindowedBatcher::stop ();.
+   */
+  ~WindowedBatcher() {
+    stop();
+  }
+
+  /**
+   * Start the batcher thread.
+   */
+  void start() {
+    m_thread = std::thread(&WindowedBatcher::run, this);
+  }
+
+  /**
+   * Submit item.
+   * @param item
+   * @return - `false` if the batcher is stopped. The item is not taken then.
+   */
+  bool submit(Item&& item) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if(!m_running) {
+      return false;
+    }
+    if(m_pending.empty()) {
+      m_pendingSince = std::chrono::steady_clock::now();
+    }
+    m_pending.push_back(std::move(item));
+    if(m_pending.size() == 1 || static_cast<v_int64>(m_pending.size()) >= m_maxBatchSize) {
+      m_condition.notify_one();
+    }
+    return true;
+  }
+
+  /**
+   * Stop batcher. Pending items are flushed, new items are rejected.
+   */
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_running = false;
+    }
+    m_condition.notify_one();
+    if(m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id()) {
+      m_thread.join();
+    }
+  }
+
+};
+
+}}
+
+#endif // oatpp_postgresql_WindowedBatcher_hpp
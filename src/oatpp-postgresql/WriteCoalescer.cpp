@@ -0,0 +1,112 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "WriteCoalescer.hpp"
+
+namespace oatpp { namespace postgresql {
+
+WriteCoalescer::WriteCoalescer(const std::shared_ptr<Executor>& executor,
+                               const data::share::StringTemplate& queryTemplate,
+                               v_int64 maxBatchSize,
+                               const std::chrono::microseconds& window)
+  : m_executor(executor)
+  , m_queryTemplate(queryTemplate)
+  , m_batcher(maxBatchSize, window, [this](std::vector<Write>& batch) { flush(batch); })
+{
+  if(maxBatchSize <= 0) {
+    throw std::runtime_error("[oatpp::postgresql::WriteCoalescer::WriteCoalescer()]: "
+                             "Error. Invalid maxBatchSize. maxBatchSize must be > 0.");
+  }
+  m_batcher.start();
+}
+
+std::shared_ptr<WriteCoalescer> WriteCoalescer::createShared(const std::shared_ptr<Executor>& executor,
+                                                             const data::share::StringTemplate& queryTemplate,
+                                                             v_int64 maxBatchSize,
+                                                             const std::chrono::microseconds& window)
+{
+  return std::make_shared<WriteCoalescer>(executor, queryTemplate, maxBatchSize, window);
+}
+
+WriteCoalescer::~WriteCoalescer() {
+  stop();
+}
+
+void WriteCoalescer::flush(std::vector<Write>& batch) {
+
+  std::vector<std::unordered_map<oatpp::String, oatpp::Void>> paramsSets;
+  paramsSets.reserve(batch.size());
+  for(auto& write : batch) {
+    paramsSets.push_back(write.params);
+  }
+
+  std::shared_ptr<orm::QueryResult> result;
+  try {
+    result = m_executor->executeBatch(m_queryTemplate, paramsSets);
+  } catch (...) {
+    auto exception = std::current_exception();
+    for(auto& write : batch) {
+      write.promise.set_exception(exception);
+    }
+    return;
+  }
+
+  if(result->isSuccess() || batch.size() == 1) {
+    for(auto& write : batch) {
+      write.promise.set_value(result);
+    }
+    return;
+  }
+
+  /* the batch is rolled back as a whole - retry writes one by one to report the outcome of each write */
+  for(auto& write : batch) {
+    try {
+      write.promise.set_value(m_executor->executeBatch(m_queryTemplate, {write.params}));
+    } catch (...) {
+      write.promise.set_exception(std::current_exception());
+    }
+  }
+
+}
+
+std::future<std::shared_ptr<orm::QueryResult>> WriteCoalescer::write(const std::unordered_map<oatpp::String, oatpp::Void>& params) {
+
+  Write write;
+  write.params = params;
+  auto future = write.promise.get_future();
+
+  if(!m_batcher.submit(std::move(write))) {
+    throw std::runtime_error("[oatpp::postgresql::WriteCoalescer::write()]: Error. Coalescer is stopped.");
+  }
+
+  return future;
+
+}
+
+void WriteCoalescer::stop() {
+  m_batcher.stop();
+}
+
+}}
@@ -0,0 +1,109 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_postgresql_WriteCoalescer_hpp
+#define oatpp_postgresql_WriteCoalescer_hpp
+
+#include "Executor.hpp"
+#include "WindowedBatcher.hpp"
+
+#include <chrono>
+#include <future>
+#include <vector>
+
+namespace oatpp { namespace postgresql {
+
+/**
+ * Group-commit coalescer of small writes. <br>
+ * Collects parameter sets submitted by many threads for the same query template and writes them
+ * with a single &id:oatpp::postgresql::Executor::executeBatch; - one connection checkout, one round trip and one commit per batch. <br>
+ * A batch is written once `maxBatchSize` writes are collected or `window` elapsed since the first write of the batch. <br>
+ * The template must be a batch template - ex.: `INSERT INTO audit (user_id, action) SELECT * FROM unnest(:userId, :action)`. <br>
+ * If the batch fails, its writes are retried one by one, so each caller gets the outcome of its own write.
+ */
+class WriteCoalescer {
+private:
+
+  struct Write {
+    std::unordered_map<oatpp::String, oatpp::Void> params;
+    std::promise<std::shared_ptr<orm::QueryResult>> promise;
+  };
+
+private:
+  void flush(std::vector<Write>& batch);
+private:
+  std::shared_ptr<Executor> m_executor;
+  data::share::StringTemplate m_queryTemplate;
+  WindowedBatcher<Write> m_batcher;
+public:
+
+  /**
+   * Constructor. Starts the flushing thread.
+   * @param executor - &id:oatpp::postgresql::Executor;.
+   * @param queryTemplate - batch query template. See &id:oatpp::postgresql::Executor::executeBatch;.
+   * @param maxBatchSize - max number of writes in one batch.
+   * @param window - max time the first write of the batch waits for other writes.
+   */
+  WriteCoalescer(const std::shared_ptr<Executor>& executor,
+                 const data::share::StringTemplate& queryTemplate,
+                 v_int64 maxBatchSize,
+                 const std::chrono::microseconds& window);
+
+  /**
+   * Create shared WriteCoalescer.
+   * @param executor - &id:oatpp::postgresql::Executor;.
+   * @param queryTemplate - batch query template. See &id:oatpp::postgresql::Executor::executeBatch;.
+   * @param maxBatchSize - max number of writes in one batch.
+   * @param window - max time the first write of the batch waits for other writes.
+   * @return - `std::shared_ptr` to WriteCoalescer.
+   */
+  static std::shared_ptr<WriteCoalescer> createShared(const std::shared_ptr<Executor>& executor,
+                                                      const data::share::StringTemplate& queryTemplate,
+                                                      v_int64 maxBatchSize = 256,
+                                                      const std::chrono::microseconds& window = std::chrono::microseconds(500));
+
+  /**
+   * Non-virtual destructor. Calls &l:WriteCoalescer::stop ();.
+   */
+  ~WriteCoalescer();
+
+  /**
+   * Submit write.
+   * @param params - query parameters of this write.
+   * @return - future of the write outcome. Writes of a successful batch share the batch &id:oatpp::orm::QueryResult;.
+   * If the batch couldn't be executed at all (ex.: no connection) the future holds the exception.
+   */
+  std::future<std::shared_ptr<orm::QueryResult>> write(const std::unordered_map<oatpp::String, oatpp::Void>& params);
+
+  /**
+   * Stop coalescer. Pending writes are flushed, new writes are rejected.
+   */
+  void stop();
+
+};
+
+}}
+
+#endif // oatpp_postgresql_WriteCoalescer_hpp
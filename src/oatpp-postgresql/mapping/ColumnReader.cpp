@@ -0,0 +1,306 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ColumnReader.hpp"
+
+#include "Oid.hpp"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+#if defined(__SSSE3__)
+  #include <tmmintrin.h>
+#endif
+
+namespace oatpp { namespace postgresql { namespace mapping {
+
+namespace {
+
+inline v_uint16 swap16(v_uint16 v) {
+  return (v_uint16) ((v << 8) | (v >> 8));
+}
+
+inline v_uint32 swap32(v_uint32 v) {
+  return ((v & 0x000000FFU) << 24) | ((v & 0x0000FF00U) << 8) |
+         ((v & 0x00FF0000U) >> 8)  | ((v & 0xFF000000U) >> 24);
+}
+
+inline v_uint64 swap64(v_uint64 v) {
+  return ((v_uint64) swap32((v_uint32) v) << 32) | swap32((v_uint32) (v >> 32));
+}
+
+bool isLittleEndian() {
+  const v_uint16 probe = 1;
+  return *reinterpret_cast<const v_uint8*>(&probe) == 1;
+}
+
+}
+
+void ColumnReader::swapBytes16(v_uint16* values, v_int64 count) {
+  if(!isLittleEndian()) {
+    return;
+  }
+  v_int64 i = 0;
+#if defined(__SSSE3__)
+  const __m128i mask = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  for(; i + 8 <= count; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_shuffle_epi8(v, mask));
+  }
+#endif
+  for(; i < count; i ++) {
+    values[i] = swap16(values[i]);
+  }
+}
+
+void ColumnReader::swapBytes32(v_uint32* values, v_int64 count) {
+  if(!isLittleEndian()) {
+    return;
+  }
+  v_int64 i = 0;
+#if defined(__SSSE3__)
+  const __m128i mask = _mm_set_epi8(12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  for(; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_shuffle_epi8(v, mask));
+  }
+#endif
+  for(; i < count; i ++) {
+    values[i] = swap32(values[i]);
+  }
+}
+
+void ColumnReader::swapBytes64(v_uint64* values, v_int64 count) {
+  if(!isLittleEndian()) {
+    return;
+  }
+  v_int64 i = 0;
+#if defined(__SSSE3__)
+  const __m128i mask = _mm_set_epi8(8, 9, 10, 11, 12, 13, 14, 15, 0, 1, 2, 3, 4, 5, 6, 7);
+  for(; i + 2 <= count; i += 2) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values + i), _mm_shuffle_epi8(v, mask));
+  }
+#endif
+  for(; i < count; i ++) {
+    values[i] = swap64(values[i]);
+  }
+}
+
+ColumnReader::Column ColumnReader::createColumn(PGresult* dbResult, v_int32 col) {
+
+  Column column;
+  column.name = (const char*) PQfname(dbResult, col);
+  column.oid = PQftype(dbResult, col);
+  column.stringOffsets.push_back(0);
+
+  switch(column.oid) {
+
+    case INT2OID:
+    case INT4OID:
+    case INT8OID:
+    case TIMESTAMPOID:
+      column.kind = Column::INT64;
+      break;
+
+    case FLOAT4OID:
+    case FLOAT8OID:
+      column.kind = Column::FLOAT64;
+      break;
+
+    case TEXTOID:
+    case VARCHAROID:
+    case CHAROID:
+    case BPCHAROID:
+      column.kind = Column::STRING;
+      return column; // string values are the same in text and binary formats
+
+    default:
+      throw std::runtime_error("[oatpp::postgresql::mapping::ColumnReader::createColumn()]: "
+                               "Error. Unsupported type of column '" + *column.name + "', OID=" + std::to_string(column.oid) + ".");
+
+  }
+
+  if(PQfformat(dbResult, col) != 1) {
+    throw std::runtime_error("[oatpp::postgresql::mapping::ColumnReader::createColumn()]: "
+                             "Error. Column '" + *column.name + "' is not in the binary format.");
+  }
+
+  return column;
+
+}
+
+const char* ColumnReader::getFixedSizeValue(PGresult* dbResult, v_int64 row, v_int32 col, v_int32 size) {
+  if(PQgetlength(dbResult, row, col) != size) {
+    throw std::runtime_error("[oatpp::postgresql::mapping::ColumnReader::getFixedSizeValue()]: "
+                             "Error. Invalid value size.");
+  }
+  return PQgetvalue(dbResult, row, col);
+}
+
+void ColumnReader::readNulls(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count) {
+  column.nullBitmap.resize((column.size + count + 7) >> 3, 0);
+  for(v_int64 i = 0; i < count; i ++) {
+    if(PQgetisnull(dbResult, fromRow + i, col)) {
+      v_int64 row = column.size + i;
+      column.nullBitmap[row >> 3] |= (v_uint8) (1 << (row & 7));
+    }
+  }
+}
+
+void ColumnReader::readInt(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count, Scratch& scratch) {
+
+  column.int64Values.resize(column.size + count);
+  v_int64* values = column.int64Values.data() + column.size;
+
+  switch(column.oid) {
+
+    case INT2OID: {
+      auto& raw = scratch.values16;
+      raw.assign(count, 0);
+      for(v_int64 i = 0; i < count; i ++) {
+        if(!column.isNull(column.size + i)) {
+          std::memcpy(&raw[i], getFixedSizeValue(dbResult, fromRow + i, col, 2), 2);
+        }
+      }
+      swapBytes16(raw.data(), count);
+      for(v_int64 i = 0; i < count; i ++) {
+        values[i] = (v_int16) raw[i];
+      }
+      break;
+    }
+
+    case INT4OID: {
+      auto& raw = scratch.values32;
+      raw.assign(count, 0);
+      for(v_int64 i = 0; i < count; i ++) {
+        if(!column.isNull(column.size + i)) {
+          std::memcpy(&raw[i], getFixedSizeValue(dbResult, fromRow + i, col, 4), 4);
+        }
+      }
+      swapBytes32(raw.data(), count);
+      for(v_int64 i = 0; i < count; i ++) {
+        values[i] = (v_int32) raw[i];
+      }
+      break;
+    }
+
+    default: {
+      /* int8 and timestamp - swap in place */
+      for(v_int64 i = 0; i < count; i ++) {
+        if(column.isNull(column.size + i)) {
+          values[i] = 0;
+        } else {
+          std::memcpy(&values[i], getFixedSizeValue(dbResult, fromRow + i, col, 8), 8);
+        }
+      }
+      swapBytes64(reinterpret_cast<v_uint64*>(values), count);
+    }
+
+  }
+
+}
+
+void ColumnReader::readFloat(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count, Scratch& scratch) {
+
+  column.float64Values.resize(column.size + count);
+  v_float64* values = column.float64Values.data() + column.size;
+
+  if(column.oid == FLOAT4OID) {
+    auto& raw = scratch.values32;
+    raw.assign(count, 0);
+    for(v_int64 i = 0; i < count; i ++) {
+      if(!column.isNull(column.size + i)) {
+        std::memcpy(&raw[i], getFixedSizeValue(dbResult, fromRow + i, col, 4), 4);
+      }
+    }
+    swapBytes32(raw.data(), count);
+    for(v_int64 i = 0; i < count; i ++) {
+      v_float32 value;
+      std::memcpy(&value, &raw[i], 4);
+      values[i] = value;
+    }
+    return;
+  }
+
+  auto& raw = scratch.values64;
+  raw.assign(count, 0);
+  for(v_int64 i = 0; i < count; i ++) {
+    if(!column.isNull(column.size + i)) {
+      std::memcpy(&raw[i], getFixedSizeValue(dbResult, fromRow + i, col, 8), 8);
+    }
+  }
+  swapBytes64(raw.data(), count);
+  std::memcpy(values, raw.data(), count * sizeof(v_uint64));
+
+}
+
+void ColumnReader::readString(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count) {
+
+  v_int64 totalSize = 0;
+  for(v_int64 i = 0; i < count; i ++) {
+    totalSize += PQgetlength(dbResult, fromRow + i, col);
+  }
+
+  v_int64 offset = column.stringData.size();
+  column.stringData.resize(offset + totalSize);
+  column.stringOffsets.reserve(column.size + count + 1);
+
+  for(v_int64 i = 0; i < count; i ++) {
+    v_int64 length = PQgetlength(dbResult, fromRow + i, col);
+    if(length > 0) {
+      std::memcpy(column.stringData.data() + offset, PQgetvalue(dbResult, fromRow + i, col), length);
+      offset += length;
+    }
+    column.stringOffsets.push_back(offset);
+  }
+
+}
+
+void ColumnReader::readRows(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count, Scratch& scratch) {
+
+  if(count <= 0) {
+    return;
+  }
+
+  readNulls(column, dbResult, col, fromRow, count);
+
+  switch(column.kind) {
+    case Column::INT64: readInt(column, dbResult, col, fromRow, count, scratch); break;
+    case Column::FLOAT64: readFloat(column, dbResult, col, fromRow, count, scratch); break;
+    case Column::STRING: readString(column, dbResult, col, fromRow, count); break;
+  }
+
+  column.size += count;
+
+}
+
+void ColumnReader::readRows(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count) {
+  Scratch scratch;
+  readRows(column, dbResult, col, fromRow, count, scratch);
+}
+
+}}}
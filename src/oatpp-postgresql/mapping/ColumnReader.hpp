@@ -0,0 +1,213 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#ifndef oatpp_postgresql_mapping_ColumnReader_hpp
+#define oatpp_postgresql_mapping_ColumnReader_hpp
+
+#include "oatpp/Types.hpp"
+
+#include <libpq-fe.h>
+
+#include <vector>
+
+namespace oatpp { namespace postgresql { namespace mapping {
+
+/**
+ * Reader of result columns into contiguous typed buffers (struct-of-arrays). <br>
+ * Values are decoded straight from the binary `PGresult` without creating oatpp objects per value.
+ */
+class ColumnReader {
+public:
+
+  /**
+   * Column values in contiguous buffers.
+   */
+  struct Column {
+
+    /**
+     * Buffer kind of the column.
+     */
+    enum Kind : v_int32 {
+
+      /**
+       * `int2`, `int4`, `int8` and `timestamp` columns - values in `int64Values`.
+       */
+      INT64 = 0,
+
+      /**
+       * `float4` and `float8` columns - values in `float64Values`.
+       */
+      FLOAT64 = 1,
+
+      /**
+       * `text`, `varchar`, `char` and `bpchar` columns - bytes in `stringData`, bounds in `stringOffsets`.
+       */
+      STRING = 2
+
+    };
+
+    /**
+     * Column name.
+     */
+    oatpp::String name;
+
+    /**
+     * Column type OID.
+     */
+    Oid oid = 0;
+
+    /**
+     * Buffer kind.
+     */
+    Kind kind = INT64;
+
+    /**
+     * Number of rows in the column.
+     */
+    v_int64 size = 0;
+
+    /**
+     * Values of `INT64` column. `0` for NULL values.
+     */
+    std::vector<v_int64> int64Values;
+
+    /**
+     * Values of `FLOAT64` column. `0` for NULL values.
+     */
+    std::vector<v_float64> float64Values;
+
+    /**
+     * Bytes of all values of `STRING` column, back to back.
+     */
+    std::vector<char> stringData;
+
+    /**
+     * `size + 1` offsets into `stringData` - value of the row `i` is `[stringOffsets[i], stringOffsets[i + 1])`.
+     */
+    std::vector<v_int64> stringOffsets;
+
+    /**
+     * Null bitmap - bit `i % 8` of byte `i / 8` is set if the value of the row `i` is NULL.
+     */
+    std::vector<v_uint8> nullBitmap;
+
+    /**
+     * Check if the value of the row is NULL.
+     * @param row
+     * @return
+     */
+    bool isNull(v_int64 row) const {
+      return (nullBitmap[row >> 3] >> (row & 7)) & 1;
+    }
+
+    /**
+     * Get string value of the row. Valid for `STRING` columns.
+     * @param row
+     * @param length - out. Length of the value.
+     * @return - pointer to the value bytes. Not null-terminated.
+     */
+    const char* getString(v_int64 row, v_buff_size& length) const {
+      length = stringOffsets[row + 1] - stringOffsets[row];
+      return stringData.data() + stringOffsets[row];
+    }
+
+  };
+
+  /**
+   * Scratch buffers for the big-endian values of narrow and floating point columns. <br>
+   * Reuse one instance across &l:ColumnReader::readRows (); calls to avoid allocating per call.
+   */
+  struct Scratch {
+    std::vector<v_uint16> values16;
+    std::vector<v_uint32> values32;
+    std::vector<v_uint64> values64;
+  };
+
+private:
+  static void readInt(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count, Scratch& scratch);
+  static void readFloat(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count, Scratch& scratch);
+  static void readString(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count);
+  static void readNulls(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count);
+  static const char* getFixedSizeValue(PGresult* dbResult, v_int64 row, v_int32 col, v_int32 size);
+public:
+
+  /**
+   * Convert big-endian values to the host byte order in place. <br>
+   * Uses SSSE3 shuffles when the library is compiled with `-mssse3` or higher (e.g. `-march=native`),
+   * scalar swaps otherwise.
+   * @param values
+   * @param count
+   */
+  static void swapBytes16(v_uint16* values, v_int64 count);
+
+  /**
+   * Convert big-endian values to the host byte order in place. Uses SSSE3 shuffles when available.
+   * @param values
+   * @param count
+   */
+  static void swapBytes32(v_uint32* values, v_int64 count);
+
+  /**
+   * Convert big-endian values to the host byte order in place. Uses SSSE3 shuffles when available.
+   * @param values
+   * @param count
+   */
+  static void swapBytes64(v_uint64* values, v_int64 count);
+
+  /**
+   * Create empty column for the result column.
+   * @param dbResult - result.
+   * @param col - column index.
+   * @return - &l:ColumnReader::Column;.
+   * @throws - `std::runtime_error` if the column type is not supported or the column is not in the binary format.
+   */
+  static Column createColumn(PGresult* dbResult, v_int32 col);
+
+  /**
+   * Append rows of the result column to the column buffers.
+   * @param column - column created with &l:ColumnReader::createColumn (); for the same result column.
+   * @param dbResult - result.
+   * @param col - column index.
+   * @param fromRow - first row to read.
+   * @param count - number of rows to read.
+   * @param scratch - &l:ColumnReader::Scratch;.
+   */
+  static void readRows(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count, Scratch& scratch);
+
+  /**
+   * Append rows of the result column to the column buffers. Allocates own scratch buffers.
+   * @param column - column created with &l:ColumnReader::createColumn (); for the same result column.
+   * @param dbResult - result.
+   * @param col - column index.
+   * @param fromRow - first row to read.
+   * @param count - number of rows to read.
+   */
+  static void readRows(Column& column, PGresult* dbResult, v_int32 col, v_int64 fromRow, v_int64 count);
+
+};
+
+}}}
+
+#endif // oatpp_postgresql_mapping_ColumnReader_hpp
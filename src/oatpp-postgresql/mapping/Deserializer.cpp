@@ -31,7 +31,7 @@
 
 namespace oatpp { namespace postgresql { namespace mapping {
 
-Deserializer::InData::InData(PGresult* dbres, int row, int col, const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver) {
+Deserializer::InData::InData(PGresult* dbres, int row, int col, const data::mapping::TypeResolver* pTypeResolver) {
   typeResolver = pTypeResolver;
   oid = PQftype(dbres, col);
   size = PQgetlength(dbres, row, col);
@@ -39,6 +39,14 @@ Deserializer::InData::InData(PGresult* dbres, int row, int col, const std::share
   isNull = PQgetisnull(dbres, row, col) == 1;
 }
 
+Deserializer::InData::InData(PGresult* dbres, int row, int col, Oid pOid, const data::mapping::TypeResolver* pTypeResolver) {
+  typeResolver = pTypeResolver;
+  oid = pOid;
+  size = PQgetlength(dbres, row, col);
+  data = PQgetvalue(dbres, row, col);
+  isNull = PQgetisnull(dbres, row, col) == 1;
+}
+
 Deserializer::Deserializer() {
 
   m_methods.resize(data::type::ClassId::getClassCount(), nullptr);
@@ -105,6 +113,88 @@ oatpp::Void Deserializer::deserialize(const InData& data, const Type* type) cons
 
 }
 
+Deserializer::DeserializerMethod Deserializer::getDeserializerMethod(const Type* type) const {
+  auto id = type->classId.id;
+  if(id < m_methods.size()) {
+    return m_methods[id];
+  }
+  return nullptr;
+}
+
+template<class IntWrapper>
+Deserializer::DeserializerMethod Deserializer::getIntDecoder(Oid oid) {
+  switch(oid) {
+    case INT2OID: return &Deserializer::decodeInt<IntWrapper, v_int16, &Deserializer::deInt2>;
+    case INT4OID: return &Deserializer::decodeInt<IntWrapper, v_int32, &Deserializer::deInt4>;
+    case INT8OID:
+    case TIMESTAMPOID: return &Deserializer::decodeInt<IntWrapper, v_int64, &Deserializer::deInt8>;
+  }
+  return nullptr;
+}
+
+template<class FloatWrapper>
+Deserializer::DeserializerMethod Deserializer::getFloatDecoder(Oid oid) {
+  switch(oid) {
+    case FLOAT4OID: return &Deserializer::decodeFloat4<FloatWrapper>;
+    case FLOAT8OID: return &Deserializer::decodeFloat8<FloatWrapper>;
+  }
+  return nullptr;
+}
+
+Deserializer::DeserializerMethod Deserializer::getAnyDecoder(Oid oid) {
+  switch(oid) {
+    case TEXTOID:
+    case VARCHAROID: return &Deserializer::decodeAny<oatpp::String, &Deserializer::decodeText>;
+    case INT2OID: return &Deserializer::decodeAny<oatpp::Int16, &Deserializer::decodeInt<oatpp::Int16, v_int16, &Deserializer::deInt2>>;
+    case INT4OID: return &Deserializer::decodeAny<oatpp::Int32, &Deserializer::decodeInt<oatpp::Int32, v_int32, &Deserializer::deInt4>>;
+    case INT8OID: return &Deserializer::decodeAny<oatpp::Int64, &Deserializer::decodeInt<oatpp::Int64, v_int64, &Deserializer::deInt8>>;
+    case TIMESTAMPOID: return &Deserializer::decodeAny<oatpp::UInt64, &Deserializer::decodeInt<oatpp::UInt64, v_int64, &Deserializer::deInt8>>;
+    case FLOAT4OID: return &Deserializer::decodeAny<oatpp::Float32, &Deserializer::decodeFloat4<oatpp::Float32>>;
+    case FLOAT8OID: return &Deserializer::decodeAny<oatpp::Float64, &Deserializer::decodeFloat8<oatpp::Float64>>;
+    case BOOLOID: return &Deserializer::decodeAny<oatpp::Boolean, &Deserializer::decodeBool>;
+  }
+  return nullptr;
+}
+
+Deserializer::DeserializerMethod Deserializer::getDecoder(Oid oid, const Type* type) const {
+
+  DeserializerMethod decoder = nullptr;
+  auto id = type->classId.id;
+
+  if(id == data::type::__class::String::CLASS_ID.id) {
+    switch(oid) {
+      case TEXTOID:
+      case CHAROID:
+      case BPCHAROID:
+      case VARCHAROID: decoder = &Deserializer::decodeText; break;
+    }
+  }
+
+  else if(id == data::type::__class::Int8::CLASS_ID.id) decoder = getIntDecoder<oatpp::Int8>(oid);
+  else if(id == data::type::__class::UInt8::CLASS_ID.id) decoder = getIntDecoder<oatpp::UInt8>(oid);
+  else if(id == data::type::__class::Int16::CLASS_ID.id) decoder = getIntDecoder<oatpp::Int16>(oid);
+  else if(id == data::type::__class::UInt16::CLASS_ID.id) decoder = getIntDecoder<oatpp::UInt16>(oid);
+  else if(id == data::type::__class::Int32::CLASS_ID.id) decoder = getIntDecoder<oatpp::Int32>(oid);
+  else if(id == data::type::__class::UInt32::CLASS_ID.id) decoder = getIntDecoder<oatpp::UInt32>(oid);
+  else if(id == data::type::__class::Int64::CLASS_ID.id) decoder = getIntDecoder<oatpp::Int64>(oid);
+  else if(id == data::type::__class::UInt64::CLASS_ID.id) decoder = getIntDecoder<oatpp::UInt64>(oid);
+
+  else if(id == data::type::__class::Float32::CLASS_ID.id) decoder = getFloatDecoder<oatpp::Float32>(oid);
+  else if(id == data::type::__class::Float64::CLASS_ID.id) decoder = getFloatDecoder<oatpp::Float64>(oid);
+
+  else if(id == data::type::__class::Boolean::CLASS_ID.id && oid == BOOLOID) decoder = &Deserializer::decodeBool;
+
+  else if(id == data::type::__class::Any::CLASS_ID.id) decoder = getAnyDecoder(oid);
+
+  if(decoder == nullptr) {
+    /* no specialization - generic method validates OID per value */
+    decoder = getDeserializerMethod(type);
+  }
+
+  return decoder;
+
+}
+
 v_int16 Deserializer::deInt2(const InData& data) {
   if(data.size != 2) {
     throw std::runtime_error("[oatpp::postgresql::mapping::Deserializer::deInt2()]: "
@@ -165,6 +255,24 @@ oatpp::Void Deserializer::deserializeString(const Deserializer* _this, const InD
 
 }
 
+oatpp::Void Deserializer::decodeText(const Deserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+  if(data.isNull) {
+    return oatpp::String();
+  }
+  return oatpp::String(data.data, data.size);
+}
+
+oatpp::Void Deserializer::decodeBool(const Deserializer* _this, const InData& data, const Type* type) {
+  (void) _this;
+  (void) type;
+  if(data.isNull) {
+    return oatpp::Boolean();
+  }
+  return oatpp::Boolean((bool) data.data[0]);
+}
+
 oatpp::Void Deserializer::deserializeFloat32(const Deserializer* _this, const InData& data, const Type* type) {
 
   (void) _this;
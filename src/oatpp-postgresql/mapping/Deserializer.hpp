@@ -48,13 +48,26 @@ namespace oatpp { namespace postgresql { namespace mapping {
 class Deserializer {
 public:
 
+  /**
+   * Value to deserialize. <br>
+   * InData is a lightweight view created per value - it borrows the value bytes and the type resolver
+   * and owns nothing. The result and the resolver must outlive it.
+   */
   struct InData {
 
     InData() = default;
 
-    InData(PGresult* dbres, int row, int col, const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver);
+    InData(PGresult* dbres, int row, int col, const data::mapping::TypeResolver* pTypeResolver);
 
-    std::shared_ptr<const data::mapping::TypeResolver> typeResolver;
+    /**
+     * Constructor for the column with known OID - skips `PQftype`.
+     */
+    InData(PGresult* dbres, int row, int col, Oid pOid, const data::mapping::TypeResolver* pTypeResolver);
+
+    /**
+     * Borrowed &id:oatpp::data::mapping::TypeResolver;. No reference counting per value.
+     */
+    const data::mapping::TypeResolver* typeResolver = nullptr;
 
     Oid oid;
     const char* data;
@@ -72,6 +85,14 @@ private:
   static v_int64 deInt(const InData& data);
 
   static const oatpp::Type* guessAnyType(const InData& data);
+
+  template<class IntWrapper>
+  static DeserializerMethod getIntDecoder(Oid oid);
+
+  template<class FloatWrapper>
+  static DeserializerMethod getFloatDecoder(Oid oid);
+
+  static DeserializerMethod getAnyDecoder(Oid oid);
 private:
   std::vector<DeserializerMethod> m_methods;
 public:
@@ -82,6 +103,23 @@ public:
 
   oatpp::Void deserialize(const InData& data, const Type* type) const;
 
+  /**
+   * Get deserializer method for type.
+   * @param type
+   * @return - method or `nullptr` if the type has no direct method (for example it's deserialized through interpretation).
+   */
+  DeserializerMethod getDeserializerMethod(const Type* type) const;
+
+  /**
+   * Get decoder for the column values of PostgreSQL type `oid` deserialized to `type`. <br>
+   * For common scalar types the decoder is specialized for the OID - it skips type and OID dispatch,
+   * so it must only be called for values of that OID. For other types it's the method of &l:Deserializer::getDeserializerMethod ();.
+   * @param oid - column type OID.
+   * @param type - target type.
+   * @return - decoder or `nullptr` if the type has no direct method.
+   */
+  DeserializerMethod getDecoder(Oid oid, const Type* type) const;
+
 private:
 
   static oatpp::Void deserializeString(const Deserializer* _this, const InData& data, const Type* type);
@@ -97,6 +135,56 @@ private:
     return IntWrapper((typename IntWrapper::UnderlyingType) value);
   }
 
+  /*
+   * Decoders specialized for the column OID. See getDecoder().
+   */
+
+  template<class IntWrapper, typename DbType, DbType (*deValue)(const InData&)>
+  static oatpp::Void decodeInt(const Deserializer* _this, const InData& data, const Type* type) {
+    (void) _this;
+    (void) type;
+    if(data.isNull) {
+      return IntWrapper();
+    }
+    return IntWrapper((typename IntWrapper::UnderlyingType) deValue(data));
+  }
+
+  template<class FloatWrapper>
+  static oatpp::Void decodeFloat4(const Deserializer* _this, const InData& data, const Type* type) {
+    (void) _this;
+    (void) type;
+    if(data.isNull) {
+      return FloatWrapper();
+    }
+    v_int32 intVal = deInt4(data);
+    return FloatWrapper((typename FloatWrapper::UnderlyingType) *((p_float32) &intVal));
+  }
+
+  template<class FloatWrapper>
+  static oatpp::Void decodeFloat8(const Deserializer* _this, const InData& data, const Type* type) {
+    (void) _this;
+    (void) type;
+    if(data.isNull) {
+      return FloatWrapper();
+    }
+    v_int64 intVal = deInt8(data);
+    return FloatWrapper((typename FloatWrapper::UnderlyingType) *((p_float64) &intVal));
+  }
+
+  template<class Wrapper, DeserializerMethod decodeValue>
+  static oatpp::Void decodeAny(const Deserializer* _this, const InData& data, const Type* type) {
+    (void) type;
+    if(data.isNull) {
+      return oatpp::Any();
+    }
+    auto value = decodeValue(_this, data, Wrapper::Class::getType());
+    auto anyHandle = std::make_shared<data::type::AnyHandle>(value.getPtr(), value.getValueType());
+    return oatpp::Void(anyHandle, Any::Class::getType());
+  }
+
+  static oatpp::Void decodeText(const Deserializer* _this, const InData& data, const Type* type);
+  static oatpp::Void decodeBool(const Deserializer* _this, const InData& data, const Type* type);
+
   static oatpp::Void deserializeFloat32(const Deserializer* _this, const InData& data, const Type* type);
   static oatpp::Void deserializeFloat64(const Deserializer* _this, const InData& data, const Type* type);
 
@@ -25,6 +25,8 @@
 #include "ResultMapper.hpp"
 #include "oatpp/base/Log.hpp"
 
+#include <limits>
+
 namespace oatpp { namespace postgresql { namespace mapping {
 
 ResultMapper::ResultData::ResultData(PGresult* pDbResult, const std::shared_ptr<const data::mapping::TypeResolver>& pTypeResolver)
@@ -40,6 +42,7 @@ ResultMapper::ResultData::ResultData(PGresult* pDbResult, const std::shared_ptr<
     for (v_int32 i = 0; i < colCount; i++) {
       oatpp::String colName = (const char*) PQfname(dbResult, i);
       colNames.push_back(colName);
+      colOids.push_back(PQftype(dbResult, i));
       colIndices.insert({colName, i});
     }
   }
@@ -72,6 +75,20 @@ ResultMapper::ResultMapper() {
 
 }
 
+Deserializer::InData ResultMapper::getInData(ResultData* dbData, v_int64 rowIndex, v_int32 col) {
+  if(dbData->copyTuple) {
+    return (*dbData->copyTuple)[col];
+  }
+  return Deserializer::InData(dbData->dbResult, rowIndex, col, dbData->colOids[col], dbData->typeResolver.get());
+}
+
+oatpp::Void ResultMapper::decode(ResultMapper* _this, Deserializer::DeserializerMethod method, const Deserializer::InData& inData, const Type* type) {
+  if(method) {
+    return (*method)(&_this->m_deserializer, inData, type);
+  }
+  return _this->m_deserializer.deserialize(inData, type);
+}
+
 void ResultMapper::setReadOneRowMethod(const data::type::ClassId& classId, ReadOneRowMethod method) {
   const v_uint32 id = classId.id;
   if(id >= m_readOneRowMethods.size()) {
@@ -94,10 +111,11 @@ oatpp::Void ResultMapper::readOneRowAsCollection(ResultMapper* _this, ResultData
   auto collection = dispatcher->createObject();
 
   const Type* itemType = *type->params.begin();
+  const auto& decoders = getValueDecoders(_this, dbData, itemType);
 
   for(v_int32 i = 0; i < dbData->colCount; i ++) {
-    mapping::Deserializer::InData inData(dbData->dbResult, rowIndex, i, dbData->typeResolver);
-    dispatcher->addItem(collection, _this->m_deserializer.deserialize(inData, itemType));
+    auto inData = getInData(dbData, rowIndex, i);
+    dispatcher->addItem(collection, decode(_this, decoders.methods[i], inData, itemType));
   }
 
   return collection;
@@ -115,30 +133,36 @@ oatpp::Void ResultMapper::readOneRowAsMap(ResultMapper* _this, ResultData* dbDat
   }
 
   const Type* valueType = dispatcher->getValueType();
+  const auto& decoders = getValueDecoders(_this, dbData, valueType);
+
   for(v_int32 i = 0; i < dbData->colCount; i ++) {
-    mapping::Deserializer::InData inData(dbData->dbResult, rowIndex, i, dbData->typeResolver);
-    dispatcher->addItem(map, dbData->colNames[i], _this->m_deserializer.deserialize(inData, valueType));
+    auto inData = getInData(dbData, rowIndex, i);
+    dispatcher->addItem(map, dbData->colNames[i], decode(_this, decoders.methods[i], inData, valueType));
   }
 
   return map;
 
 }
 
-oatpp::Void ResultMapper::readOneRowAsObject(ResultMapper* _this, ResultData* dbData, const Type* type, v_int64 rowIndex) {
+const ResultMapper::ObjectBinding& ResultMapper::getObjectBinding(ResultMapper* _this, ResultData* dbData, const Type* type) {
+
+  auto& binding = dbData->objectBinding;
+  if(binding.type == type) {
+    return binding;
+  }
 
   auto dispatcher = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
-  auto object = dispatcher->createObject();
   const auto& fieldsMap = dispatcher->getProperties()->getMap();
 
+  binding.type = nullptr;
+  binding.properties.resize(dbData->colCount);
+  binding.methods.resize(dbData->colCount);
+
   for(v_int32 i = 0; i < dbData->colCount; i ++) {
 
     auto it = fieldsMap.find(*dbData->colNames[i]);
 
-    if(it != fieldsMap.end()) {
-      auto field = it->second;
-      mapping::Deserializer::InData inData(dbData->dbResult, rowIndex, i, dbData->typeResolver);
-      field->set(static_cast<oatpp::BaseObject*>(object.get()), _this->m_deserializer.deserialize(inData, field->type));
-    } else {
+    if(it == fieldsMap.end()) {
       OATPP_LOGe("[oatpp::postgresql::mapping::ResultMapper::readRowAsObject]",
                  "Error. The object of type '{}' has no field to map column '{}'.",
                  type->nameQualifier, dbData->colNames[i]->c_str());
@@ -147,6 +171,45 @@ oatpp::Void ResultMapper::readOneRowAsObject(ResultMapper* _this, ResultData* db
                                " has no field to map column " + *dbData->colNames[i] + ".");
     }
 
+    binding.properties[i] = it->second;
+    binding.methods[i] = _this->m_deserializer.getDecoder(dbData->colOids[i], it->second->type);
+
+  }
+
+  binding.type = type;
+  return binding;
+
+}
+
+const ResultMapper::ValueDecoders& ResultMapper::getValueDecoders(ResultMapper* _this, ResultData* dbData, const Type* type) {
+
+  auto& decoders = dbData->valueDecoders;
+  if(decoders.type == type) {
+    return decoders;
+  }
+
+  decoders.methods.resize(dbData->colCount);
+  for(v_int32 i = 0; i < dbData->colCount; i ++) {
+    decoders.methods[i] = _this->m_deserializer.getDecoder(dbData->colOids[i], type);
+  }
+
+  decoders.type = type;
+  return decoders;
+
+}
+
+oatpp::Void ResultMapper::readOneRowAsObject(ResultMapper* _this, ResultData* dbData, const Type* type, v_int64 rowIndex) {
+
+  auto dispatcher = static_cast<const data::type::__class::AbstractObject::PolymorphicDispatcher*>(type->polymorphicDispatcher);
+  auto object = dispatcher->createObject();
+  auto baseObject = static_cast<oatpp::BaseObject*>(object.get());
+
+  const auto& binding = getObjectBinding(_this, dbData, type);
+
+  for(v_int32 i = 0; i < dbData->colCount; i ++) {
+    auto field = binding.properties[i];
+    auto inData = getInData(dbData, rowIndex, i);
+    field->set(baseObject, decode(_this, binding.methods[i], inData, field->type));
   }
 
   return object;
@@ -160,6 +223,17 @@ oatpp::Void ResultMapper::readRowsAsCollection(ResultMapper* _this, ResultData*
 
   const Type* itemType = dispatcher->getItemType();
 
+  if(dbData->fetchNextChunk) {
+    for(v_int64 i = 0; i < count; i++) {
+      if(dbData->rowIndex >= dbData->rowCount && !dbData->fetchNextChunk()) {
+        break;
+      }
+      dispatcher->addItem(collection, _this->readOneRow(dbData, itemType, dbData->rowIndex));
+      ++ dbData->rowIndex;
+    }
+    return collection;
+  }
+
   auto leftCount = dbData->rowCount - dbData->rowIndex;
   auto wantToRead = count;
   if(wantToRead > leftCount) {
@@ -204,7 +278,7 @@ oatpp::Void ResultMapper::readOneRow(ResultData* dbData, const Type* type, v_int
 oatpp::Void ResultMapper::readRows(ResultData* dbData, const Type* type, v_int64 count) {
 
   if(count == -1) {
-    count = dbData->rowCount;
+    count = dbData->fetchNextChunk ? std::numeric_limits<v_int64>::max() : dbData->rowCount;
   }
 
   auto id = type->classId.id;
@@ -30,6 +30,8 @@
 #include "oatpp/Types.hpp"
 #include <libpq-fe.h>
 
+#include <functional>
+
 namespace oatpp { namespace postgresql { namespace mapping {
 
 /**
@@ -38,6 +40,46 @@ namespace oatpp { namespace postgresql { namespace mapping {
 class ResultMapper {
 public:
 
+  /**
+   * Binding of result columns to the fields of a DTO type.
+   */
+  struct ObjectBinding {
+
+    /**
+     * DTO type the binding is resolved for. `nullptr` if not resolved yet.
+     */
+    const data::type::Type* type = nullptr;
+
+    /**
+     * Field for each column.
+     */
+    std::vector<oatpp::BaseObject::Property*> properties;
+
+    /**
+     * Decoder for each column. See &id:oatpp::postgresql::mapping::Deserializer::getDecoder;. <br>
+     * `nullptr` - value is deserialized with &id:oatpp::postgresql::mapping::Deserializer::deserialize;.
+     */
+    std::vector<Deserializer::DeserializerMethod> methods;
+
+  };
+
+  /**
+   * Decoders of all columns to one value type - for rows read as collections and maps.
+   */
+  struct ValueDecoders {
+
+    /**
+     * Value type the decoders are resolved for. `nullptr` if not resolved yet.
+     */
+    const data::type::Type* type = nullptr;
+
+    /**
+     * Decoder for each column. `nullptr` - value is deserialized with &id:oatpp::postgresql::mapping::Deserializer::deserialize;.
+     */
+    std::vector<Deserializer::DeserializerMethod> methods;
+
+  };
+
   /**
    * Result data.
    */
@@ -65,6 +107,11 @@ public:
      */
     std::vector<oatpp::String> colNames;
 
+    /**
+     * Column type OIDs.
+     */
+    std::vector<Oid> colOids;
+
     /**
      * Column indices.
      */
@@ -85,6 +132,30 @@ public:
      */
     v_int64 rowCount;
 
+    /**
+     * Replace `dbResult` with the next chunk of rows of the streamed result. <br>
+     * Set only for results in single-row or chunked-rows mode. `nullptr` if result is fully buffered.
+     * @return - `true` if the next chunk has rows. `false` if there are no more rows.
+     */
+    std::function<bool()> fetchNextChunk;
+
+    /**
+     * Fields of the current tuple of binary COPY output. <br>
+     * If set, row values are read from these fields instead of `dbResult`. `dbResult` only describes the columns.
+     */
+    const std::vector<Deserializer::InData>* copyTuple = nullptr;
+
+    /**
+     * Columns to fields binding of the last DTO type rows were read to.
+     * Resolved on the first row and reused for the rest of the result.
+     */
+    ObjectBinding objectBinding;
+
+    /**
+     * Column decoders of the last value type rows were read to as collections or maps.
+     */
+    ValueDecoders valueDecoders;
+
   };
 
 private:
@@ -93,6 +164,11 @@ private:
   typedef oatpp::Void (*ReadRowsMethod)(ResultMapper*, ResultData*, const Type*, v_int64);
 private:
 
+  static Deserializer::InData getInData(ResultData* dbData, v_int64 rowIndex, v_int32 col);
+  static const ObjectBinding& getObjectBinding(ResultMapper* _this, ResultData* dbData, const Type* type);
+  static const ValueDecoders& getValueDecoders(ResultMapper* _this, ResultData* dbData, const Type* type);
+  static oatpp::Void decode(ResultMapper* _this, Deserializer::DeserializerMethod method, const Deserializer::InData& inData, const Type* type);
+
   static oatpp::Void readOneRowAsCollection(ResultMapper* _this, ResultData* dbData, const Type* type, v_int64 rowIndex);
   static oatpp::Void readOneRowAsMap(ResultMapper* _this, ResultData* dbData, const Type* type, v_int64 rowIndex);
   static oatpp::Void readOneRowAsObject(ResultMapper* _this, ResultData* dbData, const Type* type, v_int64 rowIndex);
@@ -143,6 +219,7 @@ public:
 
   /**
    * Read `count` of rows to oatpp collection. <br>
+   * For streamed results rows are read across chunks - see &l:ResultMapper::ResultData::fetchNextChunk;. <br>
    * Allowed collections to store rows are:
    *
    * - &id:oatpp::Vector;
@@ -37,6 +37,49 @@
 
 namespace oatpp { namespace postgresql { namespace mapping {
 
+Serializer::OutputData::OutputData(OutputData&& other)
+  : oid(other.oid)
+  , dataBuffer(std::move(other.dataBuffer))
+  , data(other.data)
+  , dataSize(other.dataSize)
+  , dataFormat(other.dataFormat)
+{
+  if(other.data == other.inlineBuffer) {
+    std::memcpy(inlineBuffer, other.inlineBuffer, INLINE_BUFFER_SIZE);
+    data = inlineBuffer;
+  }
+  other.data = nullptr;
+  other.dataSize = -1;
+}
+
+Serializer::OutputData& Serializer::OutputData::operator=(OutputData&& other) {
+  if(this != &other) {
+    oid = other.oid;
+    dataBuffer = std::move(other.dataBuffer);
+    data = other.data;
+    dataSize = other.dataSize;
+    dataFormat = other.dataFormat;
+    if(other.data == other.inlineBuffer) {
+      std::memcpy(inlineBuffer, other.inlineBuffer, INLINE_BUFFER_SIZE);
+      data = inlineBuffer;
+    }
+    other.data = nullptr;
+    other.dataSize = -1;
+  }
+  return *this;
+}
+
+char* Serializer::OutputData::allocate(v_int32 size) {
+  if(size <= INLINE_BUFFER_SIZE) {
+    dataBuffer.reset();
+    data = inlineBuffer;
+  } else {
+    dataBuffer.reset(new char[size]);
+    data = dataBuffer.get();
+  }
+  return data;
+}
+
 Serializer::Serializer() {
   setSerializerMethods();
   setTypeOidMethods();
@@ -164,6 +207,14 @@ void Serializer::serialize(OutputData& outData, const oatpp::Void& polymorph) co
   }
 }
 
+Serializer::SerializerMethod Serializer::getSerializerMethod(const oatpp::Type* type) const {
+  auto id = type->classId.id;
+  if(id < m_methods.size()) {
+    return m_methods[id];
+  }
+  return nullptr;
+}
+
 Oid Serializer::getTypeOid(const oatpp::Type* type) const {
 
   auto id = type->classId.id;
@@ -203,8 +254,7 @@ void Serializer::serNull(OutputData& outData) {
 }
 
 void Serializer::serInt2(OutputData& outData, v_int16 value) {
-  outData.dataBuffer.reset(new char[2]);
-  outData.data = outData.dataBuffer.get();
+  outData.allocate(2);
   outData.dataSize = 2;
   outData.dataFormat = 1;
 
@@ -212,8 +262,7 @@ void Serializer::serInt2(OutputData& outData, v_int16 value) {
 }
 
 void Serializer::serInt4(OutputData& outData, v_int32 value) {
-  outData.dataBuffer.reset(new char[4]);
-  outData.data = outData.dataBuffer.get();
+  outData.allocate(4);
   outData.dataSize = 4;
   outData.dataFormat = 1;
 
@@ -221,8 +270,7 @@ void Serializer::serInt4(OutputData& outData, v_int32 value) {
 }
 
 void Serializer::serInt8(OutputData& outData, v_int64 value) {
-  outData.dataBuffer.reset(new char[8]);
-  outData.data = outData.dataBuffer.get();
+  outData.allocate(8);
   outData.dataSize = 8;
   outData.dataFormat = 1;
 
@@ -378,8 +426,7 @@ void Serializer::serializeBoolean(const Serializer* _this, OutputData& outData,
 
   if(polymorph) {
     auto v = polymorph.cast<oatpp::Boolean>();
-    outData.dataBuffer.reset(new char[1]);
-    outData.data = outData.dataBuffer.get();
+    outData.allocate(1);
     outData.dataSize = 1;
     outData.dataFormat = 1;
     outData.data[0] = (bool)v;
@@ -403,8 +450,7 @@ void Serializer::serializeEnum(const Serializer* _this, OutputData& outData, con
           enumInterpretation.getValueType()->classId == data::type::__class::String::CLASS_ID)
       {
           std::string* buff = static_cast<std::string*>(enumInterpretation.get());
-          outData.dataBuffer.reset(new char[buff->size()]);
-          outData.data = outData.dataBuffer.get();
+          outData.allocate(buff->size());
           outData.dataSize = buff->size();
           outData.dataFormat = 1;
           outData.oid = TEXTOID;
@@ -585,8 +631,7 @@ void Serializer::serializeArray(const Serializer* _this, OutputData& outData, co
 
   outData.oid = _this->getArrayTypeOid(itemType);
   outData.dataSize = stream.getCurrentPosition();
-  outData.dataBuffer.reset(new char[outData.dataSize]);
-  outData.data = outData.dataBuffer.get();
+  outData.allocate(outData.dataSize);
   outData.dataFormat = 1;
 
   std::memcpy(outData.data, stream.getData(), outData.dataSize);
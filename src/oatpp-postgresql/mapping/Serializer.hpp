@@ -46,12 +46,32 @@ namespace oatpp { namespace postgresql { namespace mapping {
 class Serializer {
 public:
 
+  /**
+   * Serialized value. <br>
+   * Values up to `INLINE_BUFFER_SIZE` bytes (all scalars) are stored in `inlineBuffer` without heap allocation.
+   */
   struct OutputData {
+
+    static constexpr v_int32 INLINE_BUFFER_SIZE = 16;
+
+    OutputData() = default;
+    OutputData(OutputData&& other);
+    OutputData& operator=(OutputData&& other);
+
+    /**
+     * Get buffer for `size` bytes of the value. Sets `data` to point to the buffer.
+     * @param size - value size in bytes.
+     * @return - pointer to the buffer.
+     */
+    char* allocate(v_int32 size);
+
     Oid oid = InvalidOid;
     std::unique_ptr<char[]> dataBuffer;
+    char inlineBuffer[INLINE_BUFFER_SIZE];
     char* data = nullptr;
     int dataSize = -1;
     int dataFormat = 1;
+
   };
 
 public:
@@ -83,6 +103,13 @@ public:
 
   void serialize(OutputData& outData, const oatpp::Void& polymorph) const;
 
+  /**
+   * Get serializer method for type.
+   * @param type
+   * @return - serializer method. `nullptr` if there is no method for the type.
+   */
+  SerializerMethod getSerializerMethod(const oatpp::Type* type) const;
+
   Oid getTypeOid(const oatpp::Type* type) const;
   Oid getArrayTypeOid(const oatpp::Type* type) const;
 
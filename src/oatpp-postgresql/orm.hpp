@@ -27,8 +27,11 @@
  * This is just a header file which includes all oatpp-postgresql components:
  *
  * ```cpp
+ * #include "BatchLoader.hpp"
  * #include "Executor.hpp"
+ * #include "ShardedConnectionPool.hpp"
  * #include "Types.hpp"
+ * #include "WriteCoalescer.hpp"
  *
  * #include "oatpp/orm/SchemaMigration.hpp"
  * #include "oatpp/orm/DbClient.hpp"
@@ -39,8 +42,11 @@
 #ifndef oatpp_postgresql_orm_hpp
 #define oatpp_postgresql_orm_hpp
 
+#include "BatchLoader.hpp"
 #include "Executor.hpp"
+#include "ShardedConnectionPool.hpp"
 #include "Types.hpp"
+#include "WriteCoalescer.hpp"
 
 #include "oatpp/orm/SchemaMigration.hpp"
 #include "oatpp/orm/DbClient.hpp"
@@ -25,11 +25,17 @@
 #ifndef oatpp_postgresql_ql_template_Parser_hpp
 #define oatpp_postgresql_ql_template_Parser_hpp
 
+#include "oatpp-postgresql/mapping/Serializer.hpp"
+
 #include "oatpp/orm/Executor.hpp"
 #include "oatpp/utils/parser/Caret.hpp"
 
 #include <libpq-fe.h>
 
+#include <atomic>
+#include <mutex>
+#include <vector>
+
 namespace oatpp { namespace postgresql { namespace ql_template {
 
 /**
@@ -38,6 +44,55 @@ namespace oatpp { namespace postgresql { namespace ql_template {
 class Parser {
 public:
 
+  /**
+   * Precompiled binding of one query parameter (`$n` placeholder) to its value. <br>
+   * All occurrences of the same template variable share one binding.
+   */
+  struct ParameterBinding {
+
+    /**
+     * Name of the template variable. For variable `:user.id` it's `user.id`.
+     */
+    oatpp::String variableName;
+
+    /**
+     * Name of the parameter in the params map. For variable `:user.id` it's `user`.
+     */
+    oatpp::String paramName;
+
+    /**
+     * Property path within the parameter value. For variable `:user.id` it's `{"id"}`.
+     */
+    std::vector<std::string> propertyPath;
+
+    /**
+     * Declared type of the parameter. `nullptr` if the type is unknown.
+     */
+    const oatpp::Type* paramType = nullptr;
+
+    /**
+     * Properties to walk from the parameter value to the variable value. <br>
+     * Resolved only if all types on the path are known DTO types - see `resolved`.
+     */
+    std::vector<oatpp::BaseObject::Property*> propertyChain;
+
+    /**
+     * Type of the variable value. `nullptr` if the property chain is not resolved.
+     */
+    const oatpp::Type* valueType = nullptr;
+
+    /**
+     * Serializer method for `valueType`. `nullptr` if not resolved.
+     */
+    mapping::Serializer::SerializerMethod serializerMethod = nullptr;
+
+    /**
+     * `true` if the property chain is resolved. Otherwise the value is resolved with &id:oatpp::data::mapping::TypeResolver;.
+     */
+    bool resolved = false;
+
+  };
+
   /**
    * Query template extra info.
    */
@@ -48,6 +103,12 @@ public:
      */
     oatpp::String templateName;
 
+    /**
+     * Dense id of the prepared template. Same for all templates with the same name. <br>
+     * Used to track prepared state on connection. `-1` - template is not prepared.
+     */
+    v_int64 templateId = -1;
+
     /**
      * Template text with parameters substituted to SQLite parameter placeholders.
      */
@@ -63,6 +124,39 @@ public:
      */
     bool prepare;
 
+    /**
+     * Binding of query parameters - one per distinct template variable, in the order of the first occurrence.
+     * Index in the plan is the index of `$n` placeholder minus one. Computed once when the template is parsed.
+     */
+    std::vector<ParameterBinding> bindingPlan;
+
+    /**
+     * Index of the binding in `bindingPlan` for each template variable.
+     * Repeated variables map to the same binding.
+     */
+    std::vector<v_uint32> variableSlots;
+
+    /**
+     * Number of executions of the unprepared template. Used for automatic promotion to the prepared statement.
+     */
+    std::atomic<v_int64> executionsCount{0};
+
+    /**
+     * Prepared copy of the unprepared template. Executed instead of the template once it's executed frequently enough.
+     * Created when the template is promoted, `nullptr` until then. Read with `std::atomic_load`.
+     */
+    std::shared_ptr<data::share::StringTemplate> promotedTemplate;
+
+    /**
+     * `false` if the template turned out not promotable - parameter types are not known.
+     */
+    std::atomic<bool> promotable{true};
+
+    /**
+     * Guards creation of `promotedTemplate`.
+     */
+    std::mutex promotionMutex;
+
   };
 
 public:
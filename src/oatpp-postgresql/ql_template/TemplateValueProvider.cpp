@@ -26,9 +26,17 @@
 
 namespace oatpp { namespace postgresql { namespace ql_template {
 
+TemplateValueProvider::TemplateValueProvider(const std::vector<v_uint32>* variableSlots)
+  : m_variableSlots(variableSlots)
+{}
+
 oatpp::String TemplateValueProvider::getValue(const data::share::StringTemplate::Variable& variable, v_uint32 index) {
+  v_uint32 slot = index;
+  if(m_variableSlots != nullptr) {
+    slot = (*m_variableSlots)[index];
+  }
   m_buffStream.setCurrentPosition(0);
-  m_buffStream << "$" << (index + 1);
+  m_buffStream << "$" << (slot + 1);
   return m_buffStream.toString();
 }
 
@@ -31,13 +31,24 @@
 namespace oatpp { namespace postgresql { namespace ql_template {
 
 /**
- * &id:oatpp::data::share::StringTemplate::ValueProvider;
+ * &id:oatpp::data::share::StringTemplate::ValueProvider;. <br>
+ * Substitutes template variables with `$n` placeholders.
  */
 class TemplateValueProvider : public data::share::StringTemplate::ValueProvider {
 private:
   data::stream::BufferOutputStream m_buffStream;
+  const std::vector<v_uint32>* m_variableSlots;
 public:
+
+  /**
+   * Constructor.
+   * @param variableSlots - parameter slot of each template variable. See &id:oatpp::postgresql::ql_template::Parser::TemplateExtra::variableSlots;.
+   * If `nullptr` - each variable gets its own slot.
+   */
+  TemplateValueProvider(const std::vector<v_uint32>* variableSlots = nullptr);
+
   oatpp::String getValue(const data::share::StringTemplate::Variable& variable, v_uint32 index) override;
+
 };
 
 }}}
@@ -0,0 +1,273 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "AsyncTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+#include "oatpp/async/Executor.hpp"
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class MyClient : public oatpp::orm::DbClient {
+public:
+
+  MyClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+
+    executeQuery("DROP TABLE IF EXISTS oatpp_schema_version_AsyncTest;", {});
+
+    oatpp::orm::SchemaMigration migration(executor, "AsyncTest");
+    migration.addFile(1, TEST_DB_MIGRATION "AsyncTest.sql");
+    migration.migrate();
+
+    auto version = executor->getSchemaVersion("AsyncTest");
+    OATPP_LOGd("DbClient", "Migration - OK. Version={}.", version);
+
+  }
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+struct Templates {
+
+  typedef oatpp::postgresql::Executor::StringTemplate StringTemplate;
+
+  Templates(const StringTemplate& pSelect,
+            const StringTemplate& pSelectPrepared,
+            const StringTemplate& pInsert,
+            const StringTemplate& pCount)
+    : select(pSelect)
+    , selectPrepared(pSelectPrepared)
+    , insert(pInsert)
+    , count(pCount)
+  {}
+
+  oatpp::postgresql::Executor::StringTemplate select;
+  oatpp::postgresql::Executor::StringTemplate selectPrepared;
+  oatpp::postgresql::Executor::StringTemplate insert;
+  oatpp::postgresql::Executor::StringTemplate count;
+};
+
+struct State {
+  std::atomic<bool> done{false};
+  std::atomic<v_int32> failures{0};
+  std::atomic<v_int64> count{-1};
+};
+
+/*
+ * select -> prepared select (x2) -> begin -> insert -> commit -> begin -> insert -> rollback -> count
+ */
+class QueriesCoroutine : public oatpp::async::Coroutine<QueriesCoroutine> {
+private:
+  std::shared_ptr<oatpp::postgresql::Executor> m_executor;
+  std::shared_ptr<Templates> m_templates;
+  std::shared_ptr<State> m_state;
+  provider::ResourceHandle<oatpp::orm::Connection> m_connection;
+  v_int32 m_preparedRuns;
+private:
+
+  bool check(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(!result || !result->isSuccess()) {
+      OATPP_LOGe("AsyncTest", "Query failed: {}", result ? result->getErrorMessage()->c_str() : "no result");
+      m_state->failures ++;
+      return false;
+    }
+    return true;
+  }
+
+  bool checkValue(const std::shared_ptr<oatpp::orm::QueryResult>& result, v_int32 expected) {
+    if(!check(result)) {
+      return false;
+    }
+    auto dataset = result->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+    if(dataset->size() != 1 || dataset[0][0] != expected) {
+      m_state->failures ++;
+      return false;
+    }
+    return true;
+  }
+
+public:
+
+  QueriesCoroutine(const std::shared_ptr<oatpp::postgresql::Executor>& executor,
+                   const std::shared_ptr<Templates>& templates,
+                   const std::shared_ptr<State>& state)
+    : m_executor(executor)
+    , m_templates(templates)
+    , m_state(state)
+    , m_preparedRuns(0)
+  {}
+
+  ~QueriesCoroutine() override {
+    m_state->done = true;
+  }
+
+  Action act() override {
+    return m_executor->executeAsync(m_templates->select, {{"value", oatpp::Int32(41)}})
+      .callbackTo(&QueriesCoroutine::onSelect);
+  }
+
+  Action onSelect(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(!checkValue(result, 42)) {
+      return finish();
+    }
+    return yieldTo(&QueriesCoroutine::selectPrepared);
+  }
+
+  Action selectPrepared() {
+    /* first run goes through Parse, second run reuses the prepared statement */
+    return m_executor->executeAsync(m_templates->selectPrepared, {{"value", oatpp::Int32(m_preparedRuns)}})
+      .callbackTo(&QueriesCoroutine::onSelectPrepared);
+  }
+
+  Action onSelectPrepared(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(!checkValue(result, m_preparedRuns + 1)) {
+      return finish();
+    }
+    m_preparedRuns ++;
+    if(m_preparedRuns < 2) {
+      return yieldTo(&QueriesCoroutine::selectPrepared);
+    }
+    return m_executor->beginAsync().callbackTo(&QueriesCoroutine::onBegin);
+  }
+
+  Action onBegin(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(!check(result) || !result->getConnection()) {
+      m_state->failures ++;
+      return finish();
+    }
+    m_connection = result->getConnection();
+    return m_executor->executeAsync(m_templates->insert, {{"id", oatpp::Int32(1)}, {"name", oatpp::String("committed")}},
+                                    nullptr, m_connection)
+      .callbackTo(&QueriesCoroutine::onInsert);
+  }
+
+  Action onInsert(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(!check(result)) {
+      return finish();
+    }
+    return m_executor->commitAsync(m_connection).callbackTo(&QueriesCoroutine::onCommit);
+  }
+
+  Action onCommit(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    m_connection = nullptr;
+    if(!check(result)) {
+      return finish();
+    }
+    return m_executor->beginAsync().callbackTo(&QueriesCoroutine::onBeginRollback);
+  }
+
+  Action onBeginRollback(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(!check(result) || !result->getConnection()) {
+      m_state->failures ++;
+      return finish();
+    }
+    m_connection = result->getConnection();
+    return m_executor->executeAsync(m_templates->insert, {{"id", oatpp::Int32(2)}, {"name", oatpp::String("rolled back")}},
+                                    nullptr, m_connection)
+      .callbackTo(&QueriesCoroutine::onInsertRollback);
+  }
+
+  Action onInsertRollback(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(!check(result)) {
+      return finish();
+    }
+    return m_executor->rollbackAsync(m_connection).callbackTo(&QueriesCoroutine::onRollback);
+  }
+
+  Action onRollback(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    m_connection = nullptr;
+    if(!check(result)) {
+      return finish();
+    }
+    return m_executor->executeAsync(m_templates->count, {}).callbackTo(&QueriesCoroutine::onCount);
+  }
+
+  Action onCount(const std::shared_ptr<oatpp::orm::QueryResult>& result) {
+    if(check(result)) {
+      auto dataset = result->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+      if(dataset->size() == 1) {
+        m_state->count = *dataset[0][0];
+      }
+    }
+    return finish();
+  }
+
+};
+
+}
+
+void AsyncTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  auto client = MyClient(executor);
+
+  auto templates = std::make_shared<Templates>(
+    executor->parseQueryTemplate(nullptr, "SELECT :value + 1", {{"value", oatpp::Int32::Class::getType()}}, false),
+    executor->parseQueryTemplate("asyncSelectPrepared", "SELECT :value + 1", {{"value", oatpp::Int32::Class::getType()}}, true),
+    executor->parseQueryTemplate("asyncInsert",
+                                 "INSERT INTO test_async (f_id, f_name) VALUES (:id, :name)",
+                                 {{"id", oatpp::Int32::Class::getType()}, {"name", oatpp::String::Class::getType()}},
+                                 true),
+    executor->parseQueryTemplate(nullptr, "SELECT count(*) FROM test_async", {}, false)
+  );
+
+  oatpp::async::Executor asyncExecutor;
+
+  {
+    auto state = std::make_shared<State>();
+    asyncExecutor.execute<QueriesCoroutine>(executor, templates, state);
+    asyncExecutor.waitTasksFinished();
+
+    OATPP_ASSERT(state->done);
+    OATPP_ASSERT(state->failures == 0);
+    OATPP_ASSERT(state->count == 1); // committed row only
+  }
+
+  /* sync API sees the same data */
+  {
+    auto res = executor->execute(templates->count, {}, nullptr, nullptr);
+    OATPP_ASSERT(res->isSuccess());
+    auto dataset = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+    OATPP_ASSERT(dataset[0][0] == 1);
+  }
+
+  asyncExecutor.waitTasksFinished();
+  asyncExecutor.stop();
+  asyncExecutor.join();
+
+}
+
+}}}}
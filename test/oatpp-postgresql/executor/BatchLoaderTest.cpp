@@ -0,0 +1,116 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BatchLoaderTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Row : public oatpp::DTO {
+
+  DTO_INIT(Row, DTO);
+
+  DTO_FIELD(Int32, id);
+  DTO_FIELD(String, name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void BatchLoaderTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  auto selectTemplate = executor->parseQueryTemplate("batchLoaderSelect",
+                                                     "SELECT * FROM ("
+                                                     "  SELECT n AS id, 'name_' || n AS name FROM generate_series(1, 100) AS n"
+                                                     "  UNION ALL SELECT 7, 'name_7_bis'"
+                                                     ") AS t WHERE id = ANY(:ids)",
+                                                     {{"ids", oatpp::Vector<oatpp::Int32>::Class::getType()}},
+                                                     true);
+
+  auto loader = oatpp::postgresql::BatchLoader::createShared<Row>(executor, selectTemplate, "ids", "id", 32, std::chrono::milliseconds(2));
+
+  /* concurrent lookups */
+  {
+    std::vector<std::thread> threads;
+    for(v_int32 t = 0; t < 8; t ++) {
+      threads.push_back(std::thread([loader, t] {
+        for(v_int32 i = 1; i <= 100; i ++) {
+          v_int32 id = (i + t * 13) % 100 + 1;
+          auto rows = loader->load(oatpp::Int32(id)).get();
+          OATPP_ASSERT(rows.size() == (id == 7 ? 2 : 1));
+          auto row = rows[0].cast<oatpp::Object<Row>>();
+          OATPP_ASSERT(row->id == id);
+        }
+      }));
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  /* duplicate and missing keys in one batch */
+  {
+    auto f1 = loader->load(oatpp::Int32(5));
+    auto f2 = loader->load(oatpp::Int32(5));
+    auto f3 = loader->load(oatpp::Int32(1000));
+
+    auto rows1 = f1.get();
+    auto rows2 = f2.get();
+    OATPP_ASSERT(rows1.size() == 1);
+    OATPP_ASSERT(rows2.size() == 1);
+    OATPP_ASSERT(rows1[0].cast<oatpp::Object<Row>>()->name == "name_5");
+    OATPP_ASSERT(f3.get().empty());
+  }
+
+  /* stopped loader rejects new lookups */
+  {
+    loader->stop();
+    bool thrown = false;
+    try {
+      loader->load(oatpp::Int32(1));
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+}
+
+}}}}
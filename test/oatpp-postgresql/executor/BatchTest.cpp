@@ -0,0 +1,161 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BatchTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Row : public oatpp::DTO {
+
+  DTO_INIT(Row, DTO);
+
+  DTO_FIELD(Int32, f_id);
+  DTO_FIELD(String, f_name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class MyClient : public oatpp::orm::DbClient {
+public:
+
+  MyClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+
+    executeQuery("DROP TABLE IF EXISTS oatpp_schema_version_BatchTest;", {});
+
+    oatpp::orm::SchemaMigration migration(executor, "BatchTest");
+    migration.addFile(1, TEST_DB_MIGRATION "BatchTest.sql");
+    migration.migrate();
+
+    auto version = executor->getSchemaVersion("BatchTest");
+    OATPP_LOGd("DbClient", "Migration - OK. Version={}.", version);
+
+  }
+
+  QUERY(selectAll, "SELECT * FROM test_batch ORDER BY f_id")
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+}
+
+void BatchTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  auto client = MyClient(executor);
+
+  auto insertTemplate = executor->parseQueryTemplate("batchInsert",
+                                                     "INSERT INTO test_batch (f_id, f_name) SELECT * FROM unnest(:id, :name)",
+                                                     {{"id", oatpp::Vector<oatpp::Int32>::Class::getType()},
+                                                      {"name", oatpp::Vector<oatpp::String>::Class::getType()}},
+                                                     true);
+
+  auto insertUnpreparedTemplate = executor->parseQueryTemplate(nullptr,
+                                                               "INSERT INTO test_batch (f_id, f_name) SELECT * FROM unnest(:id, :name)",
+                                                               {},
+                                                               false);
+
+  /* prepared - batches of different sizes share the statement */
+  for(v_int32 batchSize : {1, 10, 100}) {
+
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> batch;
+    for(v_int32 i = 0; i < batchSize; i ++) {
+      v_int32 id = batchSize * 1000 + i;
+      batch.push_back({{"id", oatpp::Int32(id)}, {"name", oatpp::String("name_" + std::to_string(id))}});
+    }
+
+    auto res = executor->executeBatch(insertTemplate, batch);
+    OATPP_ASSERT(res->isSuccess());
+
+  }
+
+  /* unprepared, with nulls */
+  {
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> batch;
+    batch.push_back({{"id", oatpp::Int32(1)}, {"name", oatpp::String(nullptr)}});
+    batch.push_back({{"id", oatpp::Int32(2)}, {"name", oatpp::String("two")}});
+
+    auto res = executor->executeBatch(insertUnpreparedTemplate, batch);
+    OATPP_ASSERT(res->isSuccess());
+  }
+
+  {
+    auto dataset = client.selectAll()->fetch<oatpp::Vector<oatpp::Object<Row>>>();
+    OATPP_ASSERT(dataset->size() == 113);
+
+    OATPP_ASSERT(dataset[0]->f_id == 1);
+    OATPP_ASSERT(dataset[0]->f_name == nullptr);
+    OATPP_ASSERT(dataset[1]->f_id == 2);
+    OATPP_ASSERT(dataset[1]->f_name == "two");
+    OATPP_ASSERT(dataset[2]->f_id == 1000);
+    OATPP_ASSERT(dataset[2]->f_name == "name_1000");
+    OATPP_ASSERT(dataset[112]->f_id == 100099);
+  }
+
+  /* duplicate key - the whole batch fails */
+  {
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> batch;
+    batch.push_back({{"id", oatpp::Int32(3)}, {"name", oatpp::String("three")}});
+    batch.push_back({{"id", oatpp::Int32(1)}, {"name", oatpp::String("duplicate")}});
+
+    auto res = executor->executeBatch(insertTemplate, batch);
+    OATPP_ASSERT(!res->isSuccess());
+
+    auto dataset = client.selectAll()->fetch<oatpp::Vector<oatpp::Object<Row>>>();
+    OATPP_ASSERT(dataset->size() == 113);
+  }
+
+  /* missing parameter */
+  {
+    std::vector<std::unordered_map<oatpp::String, oatpp::Void>> batch;
+    batch.push_back({{"id", oatpp::Int32(4)}});
+
+    bool thrown = false;
+    try {
+      executor->executeBatch(insertTemplate, batch);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+}
+
+}}}}
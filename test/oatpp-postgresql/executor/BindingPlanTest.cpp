@@ -0,0 +1,213 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "BindingPlanTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+#include "oatpp-postgresql/ql_template/Parser.hpp"
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Inner : public oatpp::DTO {
+
+  DTO_INIT(Inner, DTO);
+
+  DTO_FIELD(Int32, value);
+
+};
+
+class Outer : public oatpp::DTO {
+
+  DTO_INIT(Outer, DTO);
+
+  DTO_FIELD(String, name);
+  DTO_FIELD(Object<Inner>, inner);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+}
+
+void BindingPlanTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  auto queryTemplate = executor->parseQueryTemplate("bindingPlanSelect",
+                                                    "SELECT :outer.name, :outer.inner.value, :count",
+                                                    {{"outer", oatpp::Object<Outer>::Class::getType()},
+                                                     {"count", oatpp::Int32::Class::getType()}},
+                                                    true);
+
+  auto missingFieldTemplate = executor->parseQueryTemplate(nullptr,
+                                                           "SELECT :outer.missing",
+                                                           {{"outer", oatpp::Object<Outer>::Class::getType()}},
+                                                           false);
+
+  /* plan is computed once the template is parsed */
+  {
+    auto extra = std::static_pointer_cast<oatpp::postgresql::ql_template::Parser::TemplateExtra>(queryTemplate.getExtraData());
+    const auto& plan = extra->bindingPlan;
+    OATPP_ASSERT(plan.size() == 3);
+
+    OATPP_ASSERT(plan[0].paramName == "outer");
+    OATPP_ASSERT(plan[0].resolved);
+    OATPP_ASSERT(plan[0].propertyChain.size() == 1);
+    OATPP_ASSERT(plan[0].valueType == oatpp::String::Class::getType());
+
+    OATPP_ASSERT(plan[1].resolved);
+    OATPP_ASSERT(plan[1].propertyChain.size() == 2);
+    OATPP_ASSERT(plan[1].valueType == oatpp::Int32::Class::getType());
+
+    OATPP_ASSERT(plan[2].resolved);
+    OATPP_ASSERT(plan[2].propertyChain.empty());
+
+    /* unknown field - left for TypeResolver */
+    auto missingExtra = std::static_pointer_cast<oatpp::postgresql::ql_template::Parser::TemplateExtra>(missingFieldTemplate.getExtraData());
+    OATPP_ASSERT(missingExtra->bindingPlan.size() == 1);
+    OATPP_ASSERT(!missingExtra->bindingPlan[0].resolved);
+  }
+
+  /* resolved and runtime bindings */
+  {
+    auto outer = Outer::createShared();
+    outer->name = "outer";
+    outer->inner = Inner::createShared();
+    outer->inner->value = 7;
+
+    auto res = executor->execute(queryTemplate,
+                                 {{"outer", outer}, {"count", oatpp::Int32(3)}},
+                                 nullptr, nullptr);
+    OATPP_ASSERT(res->isSuccess());
+
+    auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Any>>>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0][0].retrieve<oatpp::String>() == "outer");
+    OATPP_ASSERT(rows[0][1].retrieve<oatpp::Int32>() == 7);
+    OATPP_ASSERT(rows[0][2].retrieve<oatpp::Int32>() == 3);
+  }
+
+  /* null object on the property path binds NULL */
+  {
+    auto outer = Outer::createShared();
+
+    auto res = executor->execute(queryTemplate,
+                                 {{"outer", outer}, {"count", oatpp::Int32(3)}},
+                                 nullptr, nullptr);
+    OATPP_ASSERT(res->isSuccess());
+
+    auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Any>>>();
+    OATPP_ASSERT(rows[0][0] == nullptr);
+    OATPP_ASSERT(rows[0][1] == nullptr);
+  }
+
+  /* unresolved binding goes through TypeResolver */
+  {
+    bool thrown = false;
+    try {
+      executor->execute(missingFieldTemplate, {{"outer", Outer::createShared()}}, nullptr, nullptr);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+  /* positional parameters - values of the variables in the template order */
+  {
+    auto res = executor->executePositional(queryTemplate,
+                                           {oatpp::String("positional"), oatpp::Int32(11), oatpp::Int32(5)},
+                                           nullptr, nullptr);
+    OATPP_ASSERT(res->isSuccess());
+
+    auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Any>>>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0][0].retrieve<oatpp::String>() == "positional");
+    OATPP_ASSERT(rows[0][1].retrieve<oatpp::Int32>() == 11);
+    OATPP_ASSERT(rows[0][2].retrieve<oatpp::Int32>() == 5);
+  }
+
+  /* positional parameters - wrong number of values */
+  {
+    bool thrown = false;
+    try {
+      executor->executePositional(queryTemplate, {oatpp::String("positional")}, nullptr, nullptr);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+  /* repeated variables share one parameter slot */
+  {
+    auto repeatedTemplate = executor->parseQueryTemplate("bindingPlanRepeated",
+                                                         "SELECT :count + :count, :outer.name, :count",
+                                                         {{"outer", oatpp::Object<Outer>::Class::getType()},
+                                                          {"count", oatpp::Int32::Class::getType()}},
+                                                         true);
+
+    auto extra = std::static_pointer_cast<oatpp::postgresql::ql_template::Parser::TemplateExtra>(repeatedTemplate.getExtraData());
+    OATPP_ASSERT(extra->preparedTemplate == "SELECT $1 + $1, $2, $1");
+    OATPP_ASSERT(extra->bindingPlan.size() == 2);
+    OATPP_ASSERT(extra->bindingPlan[0].variableName == "count");
+    OATPP_ASSERT(extra->bindingPlan[1].variableName == "outer.name");
+    OATPP_ASSERT(extra->variableSlots.size() == 4);
+    OATPP_ASSERT(extra->variableSlots[0] == 0);
+    OATPP_ASSERT(extra->variableSlots[1] == 0);
+    OATPP_ASSERT(extra->variableSlots[2] == 1);
+    OATPP_ASSERT(extra->variableSlots[3] == 0);
+
+    auto outer = Outer::createShared();
+    outer->name = "repeated";
+
+    auto res = executor->execute(repeatedTemplate,
+                                 {{"outer", outer}, {"count", oatpp::Int32(4)}},
+                                 nullptr, nullptr);
+    OATPP_ASSERT(res->isSuccess());
+
+    auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Any>>>();
+    OATPP_ASSERT(rows->size() == 1);
+    OATPP_ASSERT(rows[0][0].retrieve<oatpp::Int32>() == 8);
+    OATPP_ASSERT(rows[0][1].retrieve<oatpp::String>() == "repeated");
+    OATPP_ASSERT(rows[0][2].retrieve<oatpp::Int32>() == 4);
+
+    res = executor->executePositional(repeatedTemplate, {oatpp::Int32(5), oatpp::String("positional")}, nullptr, nullptr);
+    OATPP_ASSERT(res->isSuccess());
+
+    rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Any>>>();
+    OATPP_ASSERT(rows[0][0].retrieve<oatpp::Int32>() == 10);
+    OATPP_ASSERT(rows[0][1].retrieve<oatpp::String>() == "positional");
+    OATPP_ASSERT(rows[0][2].retrieve<oatpp::Int32>() == 5);
+  }
+
+}
+
+}}}}
@@ -0,0 +1,240 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "CopyTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Row : public oatpp::DTO {
+
+  DTO_INIT(Row, DTO);
+
+  DTO_FIELD(Int32, f_id);
+  DTO_FIELD(String, f_name);
+  DTO_FIELD(Float64, f_score);
+  DTO_FIELD(Vector<String>, f_tags);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class MyClient : public oatpp::orm::DbClient {
+public:
+
+  MyClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+
+    executeQuery("DROP TABLE IF EXISTS oatpp_schema_version_CopyTest;", {});
+
+    oatpp::orm::SchemaMigration migration(executor, "CopyTest");
+    migration.addFile(1, TEST_DB_MIGRATION "CopyTest.sql");
+    migration.migrate();
+
+    auto version = executor->getSchemaVersion("CopyTest");
+    OATPP_LOGd("DbClient", "Migration - OK. Version={}.", version);
+
+  }
+
+  QUERY(selectAll, "SELECT * FROM test_copy ORDER BY f_id")
+
+  QUERY(deleteAll, "DELETE FROM test_copy")
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+}
+
+void CopyTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  auto client = MyClient(executor);
+
+  /* collection of DTOs */
+  {
+    oatpp::Vector<oatpp::Object<Row>> rows = {};
+
+    auto row = Row::createShared();
+    row->f_id = 1;
+    row->f_name = "one";
+    row->f_score = 1.5;
+    row->f_tags = {"a", "b"};
+    rows->push_back(row);
+
+    rows->push_back(nullptr);
+
+    row = Row::createShared();
+    row->f_id = 2;
+    rows->push_back(row);
+
+    auto res = executor->copyIn("test_copy", rows);
+    OATPP_ASSERT(res->isSuccess());
+
+    auto dataset = client.selectAll()->fetch<oatpp::Vector<oatpp::Object<Row>>>();
+    OATPP_ASSERT(dataset->size() == 2);
+
+    OATPP_ASSERT(dataset[0]->f_id == 1);
+    OATPP_ASSERT(dataset[0]->f_name == "one");
+    OATPP_ASSERT(dataset[0]->f_score == 1.5);
+    OATPP_ASSERT(dataset[0]->f_tags->size() == 2);
+    OATPP_ASSERT(dataset[0]->f_tags[0] == "a");
+    OATPP_ASSERT(dataset[0]->f_tags[1] == "b");
+
+    OATPP_ASSERT(dataset[1]->f_id == 2);
+    OATPP_ASSERT(dataset[1]->f_name == nullptr);
+    OATPP_ASSERT(dataset[1]->f_score == nullptr);
+    OATPP_ASSERT(dataset[1]->f_tags == nullptr);
+  }
+
+  client.deleteAll();
+
+  /* row producer - more rows than fit in one portion */
+  {
+    v_int32 counter = 0;
+    auto res = executor->copyIn("test_copy", Row::Class::getType(), [&counter]() -> oatpp::Void {
+      if(counter >= 10000) {
+        return nullptr;
+      }
+      auto row = Row::createShared();
+      row->f_id = ++ counter;
+      row->f_name = "row_" + std::to_string(counter);
+      return row;
+    });
+    OATPP_ASSERT(res->isSuccess());
+
+    auto dataset = client.selectAll()->fetch<oatpp::Vector<oatpp::Object<Row>>>();
+    OATPP_ASSERT(dataset->size() == 10000);
+    OATPP_ASSERT(dataset[9999]->f_id == 10000);
+    OATPP_ASSERT(dataset[9999]->f_name == "row_10000");
+  }
+
+  /* constraint violation - nothing is inserted */
+  {
+    oatpp::Vector<oatpp::Object<Row>> rows = {};
+    auto row = Row::createShared();
+    row->f_id = 1;
+    rows->push_back(row);
+
+    auto res = executor->copyIn("test_copy", rows);
+    OATPP_ASSERT(!res->isSuccess());
+    OATPP_LOGd(TAG, "Expected error: {}", res->getErrorMessage()->c_str());
+  }
+
+  /* producer throws - COPY is aborted and the connection stays usable */
+  {
+    auto connection = executor->getConnection();
+
+    bool thrown = false;
+    try {
+      v_int32 counter = 0;
+      executor->copyIn("test_copy", Row::Class::getType(), [&counter]() -> oatpp::Void {
+        if(counter >= 10) {
+          throw std::runtime_error("producer error");
+        }
+        auto row = Row::createShared();
+        row->f_id = 20000 + (counter ++);
+        return row;
+      }, connection);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    auto res = client.selectAll(connection);
+    OATPP_ASSERT(res->isSuccess());
+    auto dataset = res->fetch<oatpp::Vector<oatpp::Object<Row>>>();
+    OATPP_ASSERT(dataset->size() == 10000);
+  }
+
+  /* export to DTOs */
+  {
+    v_int32 expected = 1;
+    auto res = executor->copyOut<oatpp::Object<Row>>("SELECT * FROM test_copy ORDER BY f_id", [&expected](const oatpp::Object<Row>& row) {
+      OATPP_ASSERT(row->f_id == expected);
+      OATPP_ASSERT(row->f_name == "row_" + std::to_string(expected));
+      OATPP_ASSERT(row->f_score == nullptr);
+      expected ++;
+    });
+    OATPP_ASSERT(res->isSuccess());
+    OATPP_ASSERT(expected == 10001);
+  }
+
+  /* export to collections */
+  {
+    v_int32 count = 0;
+    auto res = executor->copyOut<oatpp::Vector<oatpp::Any>>("VALUES (1::int4, 'a'::text, ARRAY['x', 'y']::text[])", [&count](const oatpp::Vector<oatpp::Any>& row) {
+      OATPP_ASSERT(row->size() == 3);
+      OATPP_ASSERT(row[0].retrieve<oatpp::Int32>() == 1);
+      OATPP_ASSERT(row[1].retrieve<oatpp::String>() == "a");
+      count ++;
+    });
+    OATPP_ASSERT(res->isSuccess());
+    OATPP_ASSERT(count == 1);
+  }
+
+  /* consumer throws - query is canceled and the connection stays usable */
+  {
+    auto connection = executor->getConnection();
+
+    bool thrown = false;
+    try {
+      executor->copyOut<oatpp::Object<Row>>("SELECT * FROM test_copy", [](const oatpp::Object<Row>& row) {
+        if(row->f_id > 10) {
+          throw std::runtime_error("consumer error");
+        }
+      }, nullptr, connection);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    auto res = client.selectAll(connection);
+    OATPP_ASSERT(res->isSuccess());
+  }
+
+  /* invalid query */
+  {
+    auto res = executor->copyOut<oatpp::Object<Row>>("SELECT * FROM no_such_table", [](const oatpp::Object<Row>& row) {
+      (void) row;
+    });
+    OATPP_ASSERT(!res->isSuccess());
+  }
+
+}
+
+}}}}
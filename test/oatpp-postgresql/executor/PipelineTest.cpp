@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "PipelineTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Row : public oatpp::DTO {
+
+  DTO_INIT(Row, DTO);
+
+  DTO_FIELD(Int32, f_id);
+  DTO_FIELD(String, f_name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class MyClient : public oatpp::orm::DbClient {
+public:
+
+  MyClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+
+    executeQuery("DROP TABLE IF EXISTS oatpp_schema_version_PipelineTest;", {});
+
+    oatpp::orm::SchemaMigration migration(executor, "PipelineTest");
+    migration.addFile(1, TEST_DB_MIGRATION "PipelineTest.sql");
+    migration.migrate();
+
+    auto version = executor->getSchemaVersion("PipelineTest");
+    OATPP_LOGd("DbClient", "Migration - OK. Version={}.", version);
+
+  }
+
+  QUERY(selectAll, "SELECT * FROM test_pipeline ORDER BY f_id")
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+}
+
+void PipelineTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  auto client = MyClient(executor);
+
+  auto insertTemplate = executor->parseQueryTemplate("pipelineInsert",
+                                                     "INSERT INTO test_pipeline (f_id, f_name) VALUES (:id, :name)",
+                                                     {{"id", oatpp::Int32::Class::getType()}, {"name", oatpp::String::Class::getType()}},
+                                                     true);
+
+  auto countTemplate = executor->parseQueryTemplate("pipelineCount",
+                                                    "SELECT count(*) FROM test_pipeline",
+                                                    {},
+                                                    false);
+
+  {
+    std::vector<oatpp::postgresql::Executor::PipelineQuery> queries;
+    queries.push_back({insertTemplate, {{"id", oatpp::Int32(1)}, {"name", oatpp::String("one")}}});
+    queries.push_back({insertTemplate, {{"id", oatpp::Int32(1)}, {"name", oatpp::String("duplicate")}}});
+    queries.push_back({insertTemplate, {{"id", oatpp::Int32(2)}, {"name", oatpp::String("two")}}});
+    queries.push_back({countTemplate, {}});
+
+    auto results = executor->executePipeline(queries);
+
+    OATPP_ASSERT(results.size() == 4);
+    OATPP_ASSERT(results[0]->isSuccess());
+    OATPP_ASSERT(!results[1]->isSuccess());
+    OATPP_ASSERT(results[2]->isSuccess());
+    OATPP_ASSERT(results[3]->isSuccess());
+
+    OATPP_LOGd(TAG, "Expected error: {}", results[1]->getErrorMessage()->c_str());
+
+    auto count = results[3]->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+    OATPP_ASSERT(count->size() == 1);
+    OATPP_ASSERT(count[0][0] == 2);
+  }
+
+  {
+    auto res = client.selectAll();
+    OATPP_ASSERT(res->isSuccess());
+
+    auto dataset = res->fetch<oatpp::Vector<oatpp::Object<Row>>>();
+    OATPP_ASSERT(dataset->size() == 2);
+    OATPP_ASSERT(dataset[0]->f_id == 1);
+    OATPP_ASSERT(dataset[0]->f_name == "one");
+    OATPP_ASSERT(dataset[1]->f_id == 2);
+    OATPP_ASSERT(dataset[1]->f_name == "two");
+  }
+
+}
+
+}}}}
@@ -0,0 +1,224 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "PreparedStatementsCacheTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+void PreparedStatementsCacheTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL, 2 /* prepared statements limit */);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  std::vector<oatpp::data::share::StringTemplate> templates;
+  for(v_int32 i = 0; i < 4; i ++) {
+    auto name = "cacheTest_" + std::to_string(i);
+    auto text = "SELECT :value + " + std::to_string(i);
+    templates.push_back(executor->parseQueryTemplate(name, text, {{"value", oatpp::Int32::Class::getType()}}, true));
+  }
+
+  auto connection = executor->getConnection();
+
+  for(v_int32 round = 0; round < 3; round ++) {
+    for(v_int32 i = 0; i < 4; i ++) {
+      auto res = executor->execute(templates[i], {{"value", oatpp::Int32(round)}}, nullptr, connection);
+      OATPP_ASSERT(res->isSuccess());
+      auto dataset = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+      OATPP_ASSERT(dataset->size() == 1);
+      OATPP_ASSERT(dataset[0][0] == round + i);
+    }
+  }
+
+  /* only "limit" statements stay prepared on the server - the rest are deallocated */
+  {
+    auto countTemplate = executor->parseQueryTemplate(nullptr,
+                                                      "SELECT count(*) FROM pg_prepared_statements WHERE name LIKE 'cacheTest_%'",
+                                                      {},
+                                                      false);
+    auto res = executor->execute(countTemplate, {}, nullptr, connection);
+    OATPP_ASSERT(res->isSuccess());
+    auto count = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+    OATPP_ASSERT(count[0][0] == 2);
+  }
+
+  /* statement evicted while transaction is aborted stays tracked until it's actually deallocated */
+  {
+    auto abortConnection = executor->getConnection();
+    auto pgConnection = std::static_pointer_cast<oatpp::postgresql::Connection>(abortConnection.object);
+
+    /* cacheTest_2 evicts cacheTest_0 - its DEALLOCATE is sent with the next query */
+    for(v_int32 i = 0; i < 3; i ++) {
+      auto res = executor->execute(templates[i], {{"value", oatpp::Int32(0)}}, nullptr, abortConnection);
+      OATPP_ASSERT(res->isSuccess());
+    }
+
+    OATPP_ASSERT(executor->begin(abortConnection)->isSuccess());
+    PQclear(PQexec(pgConnection->getHandle(), "SELECT 1 / 0"));
+    OATPP_ASSERT(PQtransactionStatus(pgConnection->getHandle()) == PQTRANS_INERROR);
+
+    /* SQL DEALLOCATE fails in the aborted transaction (protocol level Close of libpq 17+ doesn't) */
+    auto failed = executor->execute(templates[1], {{"value", oatpp::Int32(0)}}, nullptr, abortConnection);
+    OATPP_ASSERT(!failed->isSuccess());
+
+    /* statement is untracked only if it was actually deallocated */
+    auto evicted = pgConnection->getEvictedStatements();
+    OATPP_ASSERT(evicted.empty() || (evicted.size() == 1 && evicted[0] == "cacheTest_0"));
+
+    OATPP_ASSERT(executor->rollback(abortConnection)->isSuccess());
+
+    /* evicted template is executed again - no "prepared statement already exists" */
+    auto res = executor->execute(templates[0], {{"value", oatpp::Int32(5)}}, nullptr, abortConnection);
+    OATPP_ASSERT(res->isSuccess());
+    auto dataset = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+    OATPP_ASSERT(dataset[0][0] == 5);
+
+    for(v_int32 i = 0; i < 4; i ++) {
+      auto res = executor->execute(templates[i], {{"value", oatpp::Int32(1)}}, nullptr, abortConnection);
+      OATPP_ASSERT(res->isSuccess());
+    }
+
+    auto countTemplate = executor->parseQueryTemplate(nullptr,
+                                                      "SELECT count(*) FROM pg_prepared_statements WHERE name LIKE 'cacheTest_%'",
+                                                      {},
+                                                      false);
+    auto countRes = executor->execute(countTemplate, {}, nullptr, abortConnection);
+    OATPP_ASSERT(countRes->isSuccess());
+    auto count = countRes->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+    OATPP_ASSERT(count[0][0] == 2);
+    OATPP_ASSERT(pgConnection->getEvictedStatements().empty());
+  }
+
+  auto counters = connectionProvider->getPreparedStatementsCounters();
+  OATPP_LOGd(TAG, "hits={}, misses={}, evictions={}", counters.hits, counters.misses, counters.evictions);
+  OATPP_ASSERT(counters.misses > 0);
+  OATPP_ASSERT(counters.evictions > 0);
+
+  /* template repeated in a pipeline is prepared - and counted as a miss - once */
+  {
+    auto pipelineProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+    auto pipelineExecutor = std::make_shared<oatpp::postgresql::Executor>(pipelineProvider);
+
+    auto pipelineTemplate = pipelineExecutor->parseQueryTemplate("cacheTestPipeline",
+                                                                 "SELECT :value + 1",
+                                                                 {{"value", oatpp::Int32::Class::getType()}},
+                                                                 true);
+
+    std::vector<oatpp::postgresql::Executor::PipelineQuery> queries;
+    for(v_int32 i = 0; i < 3; i ++) {
+      queries.push_back({pipelineTemplate, {{"value", oatpp::Int32(i)}}});
+    }
+
+    auto results = pipelineExecutor->executePipeline(queries);
+    OATPP_ASSERT(results.size() == 3);
+    for(auto& result : results) {
+      OATPP_ASSERT(result->isSuccess());
+    }
+
+    auto pipelineCounters = pipelineProvider->getPreparedStatementsCounters();
+    OATPP_ASSERT(pipelineCounters.misses == 1);
+    OATPP_ASSERT(pipelineCounters.hits == 2);
+  }
+
+  /* registered templates are prepared before the connection is handed out */
+  {
+    auto warmProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+    auto warmExecutor = std::make_shared<oatpp::postgresql::Executor>(warmProvider);
+
+    std::vector<oatpp::data::share::StringTemplate> warmTemplates;
+    for(v_int32 i = 0; i < 3; i ++) {
+      auto name = "warmUpTest_" + std::to_string(i);
+      auto text = "SELECT :value + " + std::to_string(i);
+      warmTemplates.push_back(warmExecutor->parseQueryTemplate(name, text, {{"value", oatpp::Int32::Class::getType()}}, true));
+    }
+
+    warmProvider->setWarmUp(warmExecutor->getPreparedTemplatesWarmUp());
+
+    auto warmConnection = warmExecutor->getConnection();
+    OATPP_ASSERT(warmConnection);
+
+    auto pgConnection = std::static_pointer_cast<oatpp::postgresql::Connection>(warmConnection.object);
+#if defined(LIBPQ_HAS_PIPELINING)
+    OATPP_ASSERT(PQpipelineStatus(pgConnection->getHandle()) == PQ_PIPELINE_OFF);
+#endif
+    OATPP_ASSERT(PQisnonblocking(pgConnection->getHandle()) == 0);
+
+    auto misses = warmProvider->getPreparedStatementsCounters().misses;
+
+    for(v_int32 i = 0; i < 3; i ++) {
+      auto extra = std::static_pointer_cast<oatpp::postgresql::ql_template::Parser::TemplateExtra>(warmTemplates[i].getExtraData());
+      OATPP_ASSERT(pgConnection->isPrepared(extra->templateId));
+
+      /* prepared statement is executed right away - no Parse */
+      auto res = warmExecutor->execute(warmTemplates[i], {{"value", oatpp::Int32(10)}}, nullptr, warmConnection);
+      OATPP_ASSERT(res->isSuccess());
+      auto dataset = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+      OATPP_ASSERT(dataset[0][0] == 10 + i);
+    }
+
+    OATPP_ASSERT(warmProvider->getPreparedStatementsCounters().misses == misses);
+
+    auto countTemplate = warmExecutor->parseQueryTemplate(nullptr,
+                                                          "SELECT count(*) FROM pg_prepared_statements WHERE name LIKE 'warmUpTest_%'",
+                                                          {},
+                                                          false);
+    auto res = warmExecutor->execute(countTemplate, {}, nullptr, warmConnection);
+    OATPP_ASSERT(res->isSuccess());
+    auto count = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+    OATPP_ASSERT(count[0][0] == 3);
+  }
+
+  /* frequently executed unprepared template is promoted to prepared statement */
+  {
+    executor->setAutoPrepareThreshold(3);
+
+    auto autoTemplate = executor->parseQueryTemplate("autoPrepareTest",
+                                                     "SELECT :value + 100",
+                                                     {{"value", oatpp::Int32::Class::getType()}},
+                                                     false);
+
+    auto countTemplate = executor->parseQueryTemplate(nullptr,
+                                                      "SELECT count(*) FROM pg_prepared_statements WHERE name LIKE 'oatpp_auto_%_autoPrepareTest'",
+                                                      {},
+                                                      false);
+
+    for(v_int32 i = 0; i < 5; i ++) {
+      auto res = executor->execute(autoTemplate, {{"value", oatpp::Int32(i)}}, nullptr, connection);
+      OATPP_ASSERT(res->isSuccess());
+      auto dataset = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+      OATPP_ASSERT(dataset[0][0] == i + 100);
+
+      auto countRes = executor->execute(countTemplate, {}, nullptr, connection);
+      auto count = countRes->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+      OATPP_ASSERT(count[0][0] == (i < 2 ? 0 : 1));
+    }
+  }
+
+}
+
+}}}}
@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "StreamingTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+void StreamingTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+
+  auto seriesTemplate = executor->parseQueryTemplate("streamingSeries",
+                                                     "SELECT n FROM generate_series(1, :count) AS n",
+                                                     {{"count", oatpp::Int32::Class::getType()}},
+                                                     true);
+
+  auto connection = executor->getConnection();
+
+  for(v_int32 chunkSize : {1, 100}) {
+
+    auto res = executor->executeStreaming(seriesTemplate, {{"count", oatpp::Int32(1000)}}, chunkSize, nullptr, connection);
+    OATPP_ASSERT(res->isSuccess());
+
+    v_int64 expected = 1;
+    while(res->hasMoreToFetch()) {
+      auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>(64);
+      OATPP_ASSERT(rows->size() > 0);
+      for(auto& row : *rows) {
+        OATPP_ASSERT(row[0] == expected);
+        expected ++;
+      }
+    }
+
+    OATPP_ASSERT(expected == 1001);
+    OATPP_ASSERT(res->getPosition() == 1000);
+    OATPP_ASSERT(res->isSuccess());
+
+  }
+
+  /* fetch all at once */
+  {
+    auto res = executor->executeStreaming(seriesTemplate, {{"count", oatpp::Int32(500)}}, 1, nullptr, connection);
+    auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+    OATPP_ASSERT(rows->size() == 500);
+    OATPP_ASSERT(!res->hasMoreToFetch());
+  }
+
+  /* empty result */
+  {
+    auto res = executor->executeStreaming(seriesTemplate, {{"count", oatpp::Int32(0)}}, 1, nullptr, connection);
+    OATPP_ASSERT(res->isSuccess());
+    OATPP_ASSERT(!res->hasMoreToFetch());
+  }
+
+  /* result destroyed before all rows are read - connection stays usable */
+  {
+    {
+      auto res = executor->executeStreaming(seriesTemplate, {{"count", oatpp::Int32(100000)}}, 1, nullptr, connection);
+      auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>(10);
+      OATPP_ASSERT(rows->size() == 10);
+    }
+
+    auto res = executor->executeStreaming(seriesTemplate, {{"count", oatpp::Int32(3)}}, 1, nullptr, connection);
+    auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+    OATPP_ASSERT(rows->size() == 3);
+  }
+
+  /* server-side cursor */
+  {
+    auto begin = executor->begin(connection);
+    OATPP_ASSERT(begin->isSuccess());
+
+    {
+      auto res = executor->executeCursor(seriesTemplate, {{"count", oatpp::Int32(250)}}, 100, connection);
+      OATPP_ASSERT(res->isSuccess());
+      OATPP_ASSERT(res->getKnownCount() == 100);
+
+      v_int64 expected = 1;
+      while(res->hasMoreToFetch()) {
+        auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>(30);
+        for(auto& row : *rows) {
+          OATPP_ASSERT(row[0] == expected);
+          expected ++;
+        }
+      }
+
+      OATPP_ASSERT(expected == 251);
+      OATPP_ASSERT(res->getPosition() == 250);
+    }
+
+    {
+      auto res = executor->executeCursor(seriesTemplate, {{"count", oatpp::Int32(250)}}, 10, connection);
+      auto rows = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+      OATPP_ASSERT(rows->size() == 250);
+      OATPP_ASSERT(!res->hasMoreToFetch());
+    }
+
+    executor->rollback(connection);
+  }
+
+}
+
+}}}}
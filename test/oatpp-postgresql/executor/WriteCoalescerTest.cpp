@@ -0,0 +1,142 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "WriteCoalescerTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace postgresql { namespace executor {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DbClient)
+
+class MyClient : public oatpp::orm::DbClient {
+public:
+
+  MyClient(const std::shared_ptr<oatpp::orm::Executor>& executor)
+    : oatpp::orm::DbClient(executor)
+  {
+
+    executeQuery("DROP TABLE IF EXISTS oatpp_schema_version_WriteCoalescerTest;", {});
+
+    oatpp::orm::SchemaMigration migration(executor, "WriteCoalescerTest");
+    migration.addFile(1, TEST_DB_MIGRATION "WriteCoalescerTest.sql");
+    migration.migrate();
+
+    auto version = executor->getSchemaVersion("WriteCoalescerTest");
+    OATPP_LOGd("DbClient", "Migration - OK. Version={}.", version);
+
+  }
+
+  QUERY(count, "SELECT count(*) FROM test_coalescer")
+
+};
+
+#include OATPP_CODEGEN_END(DbClient)
+
+}
+
+void WriteCoalescerTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto connectionPool = oatpp::postgresql::ShardedConnectionPool::createShared(connectionProvider,
+                                                                               4,
+                                                                               std::chrono::seconds(3));
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionPool);
+
+  auto client = MyClient(executor);
+
+  auto insertTemplate = executor->parseQueryTemplate("coalescerInsert",
+                                                     "INSERT INTO test_coalescer (f_id, f_name) SELECT * FROM unnest(:id, :name)",
+                                                     {{"id", oatpp::Vector<oatpp::Int32>::Class::getType()},
+                                                      {"name", oatpp::Vector<oatpp::String>::Class::getType()}},
+                                                     true);
+
+  auto coalescer = oatpp::postgresql::WriteCoalescer::createShared(executor, insertTemplate, 64, std::chrono::milliseconds(2));
+
+  /* concurrent writes */
+  {
+    const v_int32 threadsCount = 8;
+    const v_int32 writesPerThread = 100;
+
+    std::vector<std::thread> threads;
+    for(v_int32 t = 0; t < threadsCount; t ++) {
+      threads.push_back(std::thread([coalescer, t, writesPerThread] {
+        for(v_int32 i = 0; i < writesPerThread; i ++) {
+          v_int32 id = t * writesPerThread + i;
+          auto result = coalescer->write({{"id", oatpp::Int32(id)}, {"name", oatpp::String("name_" + std::to_string(id))}}).get();
+          OATPP_ASSERT(result->isSuccess());
+        }
+      }));
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    auto count = client.count()->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+    OATPP_ASSERT(count[0][0] == threadsCount * writesPerThread);
+  }
+
+  /* failed write doesn't affect other writes of the batch */
+  {
+    std::vector<std::future<std::shared_ptr<orm::QueryResult>>> futures;
+    futures.push_back(coalescer->write({{"id", oatpp::Int32(10000)}, {"name", oatpp::String("ok")}}));
+    futures.push_back(coalescer->write({{"id", oatpp::Int32(0)}, {"name", oatpp::String("duplicate")}}));
+    futures.push_back(coalescer->write({{"id", oatpp::Int32(10001)}, {"name", oatpp::String("ok")}}));
+
+    OATPP_ASSERT(futures[0].get()->isSuccess());
+    OATPP_ASSERT(!futures[1].get()->isSuccess());
+    OATPP_ASSERT(futures[2].get()->isSuccess());
+
+    auto count = client.count()->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int64>>>();
+    OATPP_ASSERT(count[0][0] == 802);
+  }
+
+  /* stopped coalescer flushes pending writes and rejects new ones */
+  {
+    auto future = coalescer->write({{"id", oatpp::Int32(10002)}, {"name", oatpp::String("last")}});
+    coalescer->stop();
+    OATPP_ASSERT(future.get()->isSuccess());
+
+    bool thrown = false;
+    try {
+      coalescer->write({{"id", oatpp::Int32(10003)}, {"name", oatpp::String("rejected")}});
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+  connectionPool->stop();
+
+}
+
+}}}}
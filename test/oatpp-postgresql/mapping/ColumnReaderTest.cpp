@@ -0,0 +1,214 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ColumnReaderTest.hpp"
+
+#include "oatpp-postgresql/QueryResult.hpp"
+#include "oatpp-postgresql/mapping/Oid.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace oatpp { namespace test { namespace postgresql { namespace mapping {
+
+namespace {
+
+typedef oatpp::postgresql::mapping::ColumnReader ColumnReader;
+
+std::string toBigEndian(v_uint64 value, v_int32 size) {
+  std::string result(size, '\0');
+  for(v_int32 i = size - 1; i >= 0; i --) {
+    result[i] = (char) (value & 0xFF);
+    value >>= 8;
+  }
+  return result;
+}
+
+template<typename T, typename Raw>
+std::string toBigEndianFloat(T value) {
+  Raw raw;
+  std::memcpy(&raw, &value, sizeof(T));
+  return toBigEndian(raw, sizeof(T));
+}
+
+void setValue(PGresult* result, v_int32 row, v_int32 col, const std::string& value) {
+  OATPP_ASSERT(PQsetvalue(result, row, col, (char*) value.data(), (int) value.size()));
+}
+
+/*
+ * Build binary result with one column per supported type. Every 5th row is NULL.
+ */
+PGresult* createResult(v_int32 rowsCount) {
+
+  PGresult* result = PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK);
+
+  char smallName[] = "f_small";
+  char intName[] = "f_int";
+  char bigName[] = "f_big";
+  char realName[] = "f_real";
+  char doubleName[] = "f_double";
+  char textName[] = "f_text";
+
+  PGresAttDesc attrs[6] = {
+    {smallName, 0, 0, 1, INT2OID, 2, -1},
+    {intName, 0, 0, 1, INT4OID, 4, -1},
+    {bigName, 0, 0, 1, INT8OID, 8, -1},
+    {realName, 0, 0, 1, FLOAT4OID, 4, -1},
+    {doubleName, 0, 0, 1, FLOAT8OID, 8, -1},
+    {textName, 0, 0, 1, TEXTOID, -1, -1}
+  };
+
+  OATPP_ASSERT(PQsetResultAttrs(result, 6, attrs));
+
+  for(v_int32 i = 0; i < rowsCount; i ++) {
+
+    if(i % 5 == 0) {
+      for(v_int32 col = 0; col < 6; col ++) {
+        OATPP_ASSERT(PQsetvalue(result, i, col, nullptr, -1));
+      }
+      continue;
+    }
+
+    setValue(result, i, 0, toBigEndian((v_uint64) (v_int16) -i, 2));
+    setValue(result, i, 1, toBigEndian((v_uint64) (v_int32) (i * 100000), 4));
+    setValue(result, i, 2, toBigEndian((v_uint64) ((v_int64) i << 40), 8));
+    setValue(result, i, 3, toBigEndianFloat<v_float32, v_uint32>((v_float32) i + 0.5f));
+    setValue(result, i, 4, toBigEndianFloat<v_float64, v_uint64>((v_float64) i / 4));
+    setValue(result, i, 5, i % 3 == 0 ? std::string() : "text_" + std::to_string(i));
+
+  }
+
+  return result;
+
+}
+
+void checkColumns(const std::vector<ColumnReader::Column>& columns, v_int32 fromRow, v_int32 count) {
+
+  OATPP_ASSERT(columns.size() == 6);
+
+  for(const auto& column : columns) {
+    OATPP_ASSERT(column.size == count);
+  }
+
+  OATPP_ASSERT(columns[0].kind == ColumnReader::Column::INT64);
+  OATPP_ASSERT(columns[3].kind == ColumnReader::Column::FLOAT64);
+  OATPP_ASSERT(columns[5].kind == ColumnReader::Column::STRING);
+  OATPP_ASSERT(columns[5].name == "f_text");
+
+  for(v_int32 r = 0; r < count; r ++) {
+
+    v_int32 i = fromRow + r;
+
+    if(i % 5 == 0) {
+      for(const auto& column : columns) {
+        OATPP_ASSERT(column.isNull(r));
+      }
+      continue;
+    }
+
+    for(const auto& column : columns) {
+      OATPP_ASSERT(!column.isNull(r));
+    }
+
+    OATPP_ASSERT(columns[0].int64Values[r] == -i);
+    OATPP_ASSERT(columns[1].int64Values[r] == i * 100000);
+    OATPP_ASSERT(columns[2].int64Values[r] == (v_int64) i << 40);
+    OATPP_ASSERT(columns[3].float64Values[r] == (v_float64) ((v_float32) i + 0.5f));
+    OATPP_ASSERT(columns[4].float64Values[r] == (v_float64) i / 4);
+
+    v_buff_size length;
+    const char* text = columns[5].getString(r, length);
+    std::string expected = i % 3 == 0 ? std::string() : "text_" + std::to_string(i);
+    OATPP_ASSERT(std::string(text, length) == expected);
+
+  }
+
+}
+
+}
+
+void ColumnReaderTest::onRun() {
+
+  /* byte order conversion - odd counts cover both vector and scalar parts */
+  {
+    v_uint16 values16[11];
+    v_uint32 values32[11];
+    v_uint64 values64[11];
+    for(v_int32 i = 0; i < 11; i ++) {
+      auto be16 = toBigEndian(0x0102 + i, 2);
+      auto be32 = toBigEndian(0x01020304 + i, 4);
+      auto be64 = toBigEndian(0x0102030405060708 + i, 8);
+      std::memcpy(&values16[i], be16.data(), 2);
+      std::memcpy(&values32[i], be32.data(), 4);
+      std::memcpy(&values64[i], be64.data(), 8);
+    }
+
+    ColumnReader::swapBytes16(values16, 11);
+    ColumnReader::swapBytes32(values32, 11);
+    ColumnReader::swapBytes64(values64, 11);
+
+    for(v_int32 i = 0; i < 11; i ++) {
+      OATPP_ASSERT(values16[i] == 0x0102 + i);
+      OATPP_ASSERT(values32[i] == 0x01020304U + i);
+      OATPP_ASSERT(values64[i] == 0x0102030405060708ULL + i);
+    }
+  }
+
+  std::vector<oatpp::String> names = {"f_small", "f_int", "f_big", "f_real", "f_double", "f_text"};
+
+  /* fetch in two parts */
+  {
+    oatpp::postgresql::QueryResult result(createResult(37), nullptr, std::make_shared<oatpp::postgresql::mapping::ResultMapper>(),
+                                          std::make_shared<data::mapping::TypeResolver>());
+
+    auto columns = result.fetchColumns(names, 20);
+    checkColumns(columns, 0, 20);
+    OATPP_ASSERT(result.getPosition() == 20);
+
+    columns = result.fetchColumns(names);
+    checkColumns(columns, 20, 17);
+    OATPP_ASSERT(result.getPosition() == 37);
+
+    columns = result.fetchColumns({"f_int"});
+    OATPP_ASSERT(columns.size() == 1);
+    OATPP_ASSERT(columns[0].size == 0);
+  }
+
+  /* unknown column */
+  {
+    oatpp::postgresql::QueryResult result(createResult(1), nullptr, std::make_shared<oatpp::postgresql::mapping::ResultMapper>(),
+                                          std::make_shared<data::mapping::TypeResolver>());
+    bool thrown = false;
+    try {
+      result.fetchColumns({"f_missing"});
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+}
+
+}}}}
@@ -0,0 +1,257 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ResultMapperTest.hpp"
+
+#include "oatpp-postgresql/mapping/ResultMapper.hpp"
+#include "oatpp-postgresql/mapping/Oid.hpp"
+
+#include "oatpp/macro/codegen.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace oatpp { namespace test { namespace postgresql { namespace mapping {
+
+namespace {
+
+#include OATPP_CODEGEN_BEGIN(DTO)
+
+class Row : public oatpp::DTO {
+
+  DTO_INIT(Row, DTO);
+
+  DTO_FIELD(Int32, f_id);
+  DTO_FIELD(String, f_name);
+  DTO_FIELD(Int64, f_value);
+
+};
+
+class NarrowRow : public oatpp::DTO {
+
+  DTO_INIT(NarrowRow, DTO);
+
+  DTO_FIELD(Int32, f_id);
+  DTO_FIELD(String, f_name);
+
+};
+
+#include OATPP_CODEGEN_END(DTO)
+
+/* InData is a borrowed view - no owning members, no reference counting per decoded value */
+static_assert(std::is_trivially_copyable<oatpp::postgresql::mapping::Deserializer::InData>::value,
+              "Deserializer::InData must stay trivially copyable");
+
+struct ResultDeleter {
+  void operator()(PGresult* result) const {
+    PQclear(result);
+  }
+};
+
+std::string toBigEndian(v_uint64 value, v_int32 size) {
+  std::string result(size, '\0');
+  for(v_int32 i = size - 1; i >= 0; i --) {
+    result[i] = (char) (value & 0xFF);
+    value >>= 8;
+  }
+  return result;
+}
+
+/*
+ * Build binary result (f_id int4, f_name text, f_value int8) without a server.
+ */
+std::unique_ptr<PGresult, ResultDeleter> createResult(v_int32 rowsCount) {
+
+  std::unique_ptr<PGresult, ResultDeleter> result(PQmakeEmptyPGresult(nullptr, PGRES_TUPLES_OK));
+
+  char idName[] = "f_id";
+  char nameName[] = "f_name";
+  char valueName[] = "f_value";
+
+  PGresAttDesc attrs[3] = {
+    {idName, 0, 0, 1, INT4OID, 4, -1},
+    {nameName, 0, 0, 1, TEXTOID, -1, -1},
+    {valueName, 0, 0, 1, INT8OID, 8, -1}
+  };
+
+  OATPP_ASSERT(PQsetResultAttrs(result.get(), 3, attrs));
+
+  for(v_int32 i = 0; i < rowsCount; i ++) {
+
+    auto id = toBigEndian((v_uint64) i, 4);
+    auto name = "name_" + std::to_string(i);
+    auto value = toBigEndian((v_uint64) i * 1000, 8);
+
+    OATPP_ASSERT(PQsetvalue(result.get(), i, 0, (char*) id.data(), (int) id.size()));
+    OATPP_ASSERT(PQsetvalue(result.get(), i, 1, (char*) name.data(), (int) name.size()));
+    if(i % 2 == 0) {
+      OATPP_ASSERT(PQsetvalue(result.get(), i, 2, (char*) value.data(), (int) value.size()));
+    } else {
+      OATPP_ASSERT(PQsetvalue(result.get(), i, 2, nullptr, -1));
+    }
+
+  }
+
+  return result;
+
+}
+
+}
+
+void ResultMapperTest::onRun() {
+
+  oatpp::postgresql::mapping::ResultMapper mapper;
+  auto typeResolver = std::make_shared<data::mapping::TypeResolver>();
+
+  /* rows mapped to DTO through the column binding resolved once per result */
+  {
+    auto result = createResult(100);
+    oatpp::postgresql::mapping::ResultMapper::ResultData resultData(result.get(), typeResolver);
+
+    auto rows = mapper.readRows(&resultData, oatpp::Vector<oatpp::Object<Row>>::Class::getType(), -1)
+      .cast<oatpp::Vector<oatpp::Object<Row>>>();
+
+    OATPP_ASSERT(rows->size() == 100);
+    OATPP_ASSERT(resultData.objectBinding.type == oatpp::Object<Row>::Class::getType());
+    OATPP_ASSERT(resultData.objectBinding.properties.size() == 3);
+
+    for(v_int32 i = 0; i < 100; i ++) {
+      OATPP_ASSERT(rows[i]->f_id == i);
+      OATPP_ASSERT(rows[i]->f_name == "name_" + std::to_string(i));
+      if(i % 2 == 0) {
+        OATPP_ASSERT(rows[i]->f_value == (v_int64) i * 1000);
+      } else {
+        OATPP_ASSERT(rows[i]->f_value == nullptr);
+      }
+    }
+  }
+
+  /* binding is re-resolved when rows are read to another type */
+  {
+    auto result = createResult(2);
+    oatpp::postgresql::mapping::ResultMapper::ResultData resultData(result.get(), typeResolver);
+
+    auto row = mapper.readOneRow(&resultData, oatpp::Object<Row>::Class::getType(), 0).cast<oatpp::Object<Row>>();
+    OATPP_ASSERT(row->f_id == 0);
+
+    auto fields = mapper.readOneRow(&resultData, oatpp::Fields<oatpp::Any>::Class::getType(), 1)
+      .cast<oatpp::Fields<oatpp::Any>>();
+    OATPP_ASSERT(fields->size() == 3);
+
+    bool thrown = false;
+    try {
+      mapper.readOneRow(&resultData, oatpp::Object<NarrowRow>::Class::getType(), 1);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+
+    row = mapper.readOneRow(&resultData, oatpp::Object<Row>::Class::getType(), 1).cast<oatpp::Object<Row>>();
+    OATPP_ASSERT(row->f_id == 1);
+    OATPP_ASSERT(row->f_name == "name_1");
+  }
+
+  /* column decoders are specialized for the column OIDs */
+  {
+    auto result = createResult(2);
+    oatpp::postgresql::mapping::ResultMapper::ResultData resultData(result.get(), typeResolver);
+
+    OATPP_ASSERT(resultData.colOids.size() == 3);
+    OATPP_ASSERT(resultData.colOids[0] == INT4OID);
+    OATPP_ASSERT(resultData.colOids[1] == TEXTOID);
+    OATPP_ASSERT(resultData.colOids[2] == INT8OID);
+
+    auto rows = mapper.readRows(&resultData, oatpp::Vector<oatpp::Vector<oatpp::Any>>::Class::getType(), -1)
+      .cast<oatpp::Vector<oatpp::Vector<oatpp::Any>>>();
+
+    OATPP_ASSERT(resultData.valueDecoders.type == oatpp::Any::Class::getType());
+    OATPP_ASSERT(resultData.valueDecoders.methods.size() == 3);
+
+    OATPP_ASSERT(rows->size() == 2);
+    OATPP_ASSERT(rows[0][0].getStoredType() == oatpp::Int32::Class::getType());
+    OATPP_ASSERT(rows[0][0].retrieve<oatpp::Int32>() == 0);
+    OATPP_ASSERT(rows[0][1].retrieve<oatpp::String>() == "name_0");
+    OATPP_ASSERT(rows[0][2].getStoredType() == oatpp::Int64::Class::getType());
+    OATPP_ASSERT(rows[0][2].retrieve<oatpp::Int64>() == 0);
+    OATPP_ASSERT(rows[1][2] == nullptr);
+
+    /* no specialization for text to int - generic method reports the error */
+    bool thrown = false;
+    try {
+      mapper.readOneRow(&resultData, oatpp::Vector<oatpp::Int64>::Class::getType(), 0);
+    } catch (const std::runtime_error&) {
+      thrown = true;
+    }
+    OATPP_ASSERT(thrown);
+  }
+
+  /* concurrent decode - threads share one type resolver */
+  {
+    const v_int32 threadsCount = 4;
+    const v_int32 rowsCount = 50000;
+
+    std::vector<std::unique_ptr<PGresult, ResultDeleter>> results;
+    for(v_int32 i = 0; i < threadsCount; i ++) {
+      results.push_back(createResult(rowsCount));
+    }
+
+    std::shared_ptr<const data::mapping::TypeResolver> sharedResolver = typeResolver;
+
+    std::atomic<v_int64> decodedCount(0);
+    std::vector<std::thread> threads;
+
+    auto start = std::chrono::steady_clock::now();
+
+    for(v_int32 t = 0; t < threadsCount; t ++) {
+      PGresult* result = results[t].get();
+      threads.push_back(std::thread([&mapper, &decodedCount, sharedResolver, result, rowsCount] {
+        oatpp::postgresql::mapping::ResultMapper::ResultData resultData(result, sharedResolver);
+        auto rows = mapper.readRows(&resultData, oatpp::Vector<oatpp::Object<Row>>::Class::getType(), -1)
+          .cast<oatpp::Vector<oatpp::Object<Row>>>();
+        OATPP_ASSERT(rows->size() == (size_t) rowsCount);
+        OATPP_ASSERT(rows[rowsCount - 1]->f_id == rowsCount - 1);
+        decodedCount += rows->size();
+      }));
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    OATPP_ASSERT(decodedCount == (v_int64) threadsCount * rowsCount);
+
+    OATPP_LOGd(TAG, "{} threads decoded {} rows of 3 columns: {}us", threadsCount, decodedCount.load(), elapsed);
+  }
+
+}
+
+}}}}
@@ -0,0 +1,196 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "SerializerAllocationTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/*
+ * Replacement of global allocation functions. Linked into the module-allocation-tests binary only.
+ * Allocations are counted while g_countAllocations is set.
+ * The binary is C++11 - there are no aligned (C++17) or sized (C++14) forms to replace.
+ */
+
+namespace {
+
+std::atomic<bool> g_countAllocations(false);
+std::atomic<v_int64> g_allocationsCount(0);
+
+void* allocate(std::size_t size) noexcept {
+  if(g_countAllocations.load(std::memory_order_relaxed)) {
+    g_allocationsCount ++;
+  }
+  return std::malloc(size > 0 ? size : 1);
+}
+
+}
+
+void* operator new(std::size_t size) {
+  void* ptr = allocate(size);
+  if(ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size) {
+  void* ptr = allocate(size);
+  if(ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept {
+  std::free(ptr);
+}
+
+namespace oatpp { namespace test { namespace postgresql { namespace mapping {
+
+namespace {
+
+/*
+ * Number of heap allocations made by the function.
+ */
+template<class F>
+v_int64 countAllocations(const F& f) {
+  auto before = g_allocationsCount.load();
+  g_countAllocations = true;
+  f();
+  g_countAllocations = false;
+  return g_allocationsCount.load() - before;
+}
+
+}
+
+void SerializerAllocationTest::onRun() {
+
+  typedef oatpp::postgresql::Executor::QueryParams QueryParams;
+
+  oatpp::postgresql::mapping::Serializer serializer;
+
+  const v_int64 iterations = 1000;
+
+  /* typical query parameters */
+  std::unordered_map<oatpp::String, oatpp::Void> params = {
+    {"a", oatpp::Int32(1)},
+    {"b", oatpp::Int64(2)},
+    {"c", oatpp::Float64(3.0)},
+    {"d", oatpp::Boolean(true)},
+    {"e", oatpp::String("name")}
+  };
+
+  std::vector<oatpp::Void> positionalParams = {
+    params["a"], params["b"], params["c"], params["d"], params["e"]
+  };
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionProvider);
+  std::shared_ptr<const oatpp::data::mapping::TypeResolver> typeResolver = executor->createTypeResolver();
+
+  auto queryTemplate = executor->parseQueryTemplate("allocationTestSelect",
+                                                    "SELECT :a, :b, :c, :d, :e",
+                                                    {{"a", oatpp::Int32::Class::getType()},
+                                                     {"b", oatpp::Int64::Class::getType()},
+                                                     {"c", oatpp::Float64::Class::getType()},
+                                                     {"d", oatpp::Boolean::Class::getType()},
+                                                     {"e", oatpp::String::Class::getType()}},
+                                                    false);
+
+  /* named parameters - the path of execute() and DbClient QUERY methods */
+  {
+    auto allocations = countAllocations([&] {
+      for(v_int64 i = 0; i < iterations; i ++) {
+        QueryParams queryParams(queryTemplate, params, serializer, typeResolver);
+        OATPP_ASSERT(queryParams.count == 5);
+      }
+    });
+    OATPP_LOGd(TAG, "{} bindings of 5 named parameters: {} heap allocations", iterations, allocations);
+    OATPP_ASSERT(allocations == 0);
+  }
+
+  /* positional parameters */
+  {
+    auto allocations = countAllocations([&] {
+      for(v_int64 i = 0; i < iterations; i ++) {
+        QueryParams queryParams(queryTemplate, positionalParams, serializer);
+        OATPP_ASSERT(queryParams.count == 5);
+      }
+    });
+    OATPP_LOGd(TAG, "{} bindings of 5 positional parameters: {} heap allocations", iterations, allocations);
+    OATPP_ASSERT(allocations == 0);
+  }
+
+  /* values larger than the inline buffer still go to the heap */
+  {
+    oatpp::Vector<oatpp::Int32> array = {1, 2, 3, 4, 5};
+    oatpp::postgresql::mapping::Serializer::OutputData outData;
+
+    auto allocations = countAllocations([&] {
+      serializer.serialize(outData, array);
+    });
+    OATPP_ASSERT(allocations > 0);
+    OATPP_ASSERT(outData.data == outData.dataBuffer.get());
+  }
+
+  /* moved value keeps pointing to its own inline buffer */
+  {
+    oatpp::postgresql::mapping::Serializer::OutputData outData;
+    serializer.serialize(outData, oatpp::Int32(7));
+    OATPP_ASSERT(outData.data == outData.inlineBuffer);
+
+    oatpp::postgresql::mapping::Serializer::OutputData moved(std::move(outData));
+    OATPP_ASSERT(moved.data == moved.inlineBuffer);
+    OATPP_ASSERT(moved.dataSize == 4);
+    OATPP_ASSERT(ntohl(*reinterpret_cast<v_int32*>(moved.data)) == 7);
+  }
+
+}
+
+}}}}
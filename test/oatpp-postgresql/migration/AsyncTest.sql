@@ -0,0 +1,6 @@
+DROP TABLE IF EXISTS test_async;
+
+CREATE TABLE test_async (
+  f_id      integer PRIMARY KEY,
+  f_name    varchar(256)
+);
@@ -0,0 +1,6 @@
+DROP TABLE IF EXISTS test_batch;
+
+CREATE TABLE test_batch (
+  f_id      integer PRIMARY KEY,
+  f_name    text
+);
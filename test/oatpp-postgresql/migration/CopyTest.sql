@@ -0,0 +1,8 @@
+DROP TABLE IF EXISTS test_copy;
+
+CREATE TABLE test_copy (
+  f_id      integer PRIMARY KEY,
+  f_name    text,
+  f_score   float8,
+  f_tags    text[]
+);
@@ -0,0 +1,6 @@
+DROP TABLE IF EXISTS test_pipeline;
+
+CREATE TABLE test_pipeline (
+  f_id      integer PRIMARY KEY,
+  f_name    varchar(256)
+);
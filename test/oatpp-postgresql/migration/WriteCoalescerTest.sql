@@ -0,0 +1,6 @@
+DROP TABLE IF EXISTS test_coalescer;
+
+CREATE TABLE test_coalescer (
+  f_id      integer PRIMARY KEY,
+  f_name    text
+);
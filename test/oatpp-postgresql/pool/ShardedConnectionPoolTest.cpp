@@ -0,0 +1,130 @@
+/***************************************************************************
+ *
+ * Project         _____    __   ____   _      _
+ *                (  _  )  /__\ (_  _)_| |_  _| |_
+ *                 )(_)(  /(__)\  )( (_   _)(_   _)
+ *                (_____)(__)(__)(__)  |_|    |_|
+ *
+ *
+ * Copyright 2018-present, Leonid Stryzhevskyi <lganzzzo@gmail.com>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ ***************************************************************************/
+
+
+#include "ShardedConnectionPoolTest.hpp"
+
+#include "oatpp-postgresql/orm.hpp"
+
+#include <thread>
+
+namespace oatpp { namespace test { namespace postgresql { namespace pool {
+
+void ShardedConnectionPoolTest::onRun() {
+
+  OATPP_LOGi(TAG, "DB-URL='{}'", TEST_DB_URL);
+
+  auto connectionProvider = std::make_shared<oatpp::postgresql::ConnectionProvider>(TEST_DB_URL);
+  auto connectionPool = oatpp::postgresql::ShardedConnectionPool::createShared(connectionProvider,
+                                                                               4,
+                                                                               std::chrono::seconds(3),
+                                                                               std::chrono::milliseconds(500),
+                                                                               4);
+
+  /* pool size is limited */
+  {
+    std::vector<provider::ResourceHandle<oatpp::postgresql::Connection>> connections;
+    for(v_int32 i = 0; i < 4; i ++) {
+      auto connection = connectionPool->get();
+      OATPP_ASSERT(connection);
+      connections.push_back(connection);
+    }
+    OATPP_ASSERT(connectionPool->getSize() == 4);
+
+    auto connection = connectionPool->get();
+    OATPP_ASSERT(!connection);
+  }
+
+  /* released connections are reused */
+  OATPP_ASSERT(connectionPool->getSize() == 4);
+  {
+    auto connection = connectionPool->get();
+    OATPP_ASSERT(connection);
+    OATPP_ASSERT(connectionPool->getSize() == 4);
+  }
+
+  /* many threads share few connections */
+  {
+    auto executor = std::make_shared<oatpp::postgresql::Executor>(connectionPool);
+    auto queryTemplate = executor->parseQueryTemplate("poolTestSelect",
+                                                      "SELECT :value + 1",
+                                                      {{"value", oatpp::Int32::Class::getType()}},
+                                                      true);
+
+    std::atomic<v_int32> failures(0);
+    std::vector<std::thread> threads;
+
+    for(v_int32 t = 0; t < 16; t ++) {
+      threads.push_back(std::thread([executor, queryTemplate, t, &failures] {
+        for(v_int32 i = 0; i < 50; i ++) {
+          auto res = executor->execute(queryTemplate, {{"value", oatpp::Int32(t * 100 + i)}}, nullptr, nullptr);
+          if(!res->isSuccess()) {
+            failures ++;
+            continue;
+          }
+          auto dataset = res->fetch<oatpp::Vector<oatpp::Vector<oatpp::Int32>>>();
+          if(dataset[0][0] != t * 100 + i + 1) {
+            failures ++;
+          }
+        }
+      }));
+    }
+
+    for(auto& thread : threads) {
+      thread.join();
+    }
+
+    OATPP_ASSERT(failures == 0);
+    OATPP_ASSERT(connectionPool->getSize() <= 4);
+  }
+
+  /* connection goes back to the pool while the result is still alive */
+  {
+    auto singleConnectionPool = oatpp::postgresql::ShardedConnectionPool::createShared(connectionProvider,
+                                                                                       1,
+                                                                                       std::chrono::seconds(3),
+                                                                                       std::chrono::milliseconds(200));
+    auto executor = std::make_shared<oatpp::postgresql::Executor>(singleConnectionPool);
+    auto queryTemplate = executor->parseQueryTemplate(nullptr, "SELECT 1", {}, false);
+
+    auto res1 = executor->execute(queryTemplate, {}, nullptr, nullptr);
+    auto res2 = executor->execute(queryTemplate, {}, nullptr, nullptr);
+    OATPP_ASSERT(res1->isSuccess());
+    OATPP_ASSERT(res2->isSuccess());
+    OATPP_ASSERT(!res1->getConnection());
+
+    /* connection in transaction is kept */
+    auto begin = executor->begin();
+    OATPP_ASSERT(begin->getConnection());
+    executor->rollback(begin->getConnection());
+
+    singleConnectionPool->stop();
+  }
+
+  connectionPool->stop();
+  OATPP_ASSERT(connectionPool->getSize() == 0);
+
+}
+
+}}}}
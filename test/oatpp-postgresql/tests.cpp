@@ -1,4 +1,20 @@
 
+#include "executor/AsyncTest.hpp"
+#include "executor/BatchLoaderTest.hpp"
+#include "executor/BatchTest.hpp"
+#include "executor/BindingPlanTest.hpp"
+#include "executor/CopyTest.hpp"
+#include "executor/PipelineTest.hpp"
+#include "executor/PreparedStatementsCacheTest.hpp"
+#include "executor/StreamingTest.hpp"
+#include "executor/WriteCoalescerTest.hpp"
+
+#include "mapping/ColumnReaderTest.hpp"
+#include "mapping/ResultMapperTest.hpp"
+
+#include "pool/ConnectionProviderAsyncTest.hpp"
+#include "pool/ShardedConnectionPoolTest.hpp"
+
 #include "ql_template/ParserTest.hpp"
 
 #include "types/ArrayTest.hpp"
@@ -38,12 +54,28 @@ void runTests() {
 
   OATPP_RUN_TEST(oatpp::test::postgresql::ql_template::ParserTest);
 
+  OATPP_RUN_TEST(oatpp::test::postgresql::mapping::ResultMapperTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::mapping::ColumnReaderTest);
+
   OATPP_RUN_TEST(oatpp::test::postgresql::types::IntTest);
   OATPP_RUN_TEST(oatpp::test::postgresql::types::FloatTest);
   OATPP_RUN_TEST(oatpp::test::postgresql::types::ArrayTest);
   OATPP_RUN_TEST(oatpp::test::postgresql::types::InterpretationTest);
   OATPP_RUN_TEST(oatpp::test::postgresql::types::CharacterTest);
   OATPP_RUN_TEST(oatpp::test::postgresql::types::EnumAsStringTest);
+
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::BindingPlanTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::PipelineTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::PreparedStatementsCacheTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::StreamingTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::CopyTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::BatchTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::WriteCoalescerTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::BatchLoaderTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::executor::AsyncTest);
+
+  OATPP_RUN_TEST(oatpp::test::postgresql::pool::ConnectionProviderAsyncTest);
+  OATPP_RUN_TEST(oatpp::test::postgresql::pool::ShardedConnectionPoolTest);
 }
 
 }